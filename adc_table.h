@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include "types.h"
+
+/*  Precomputed results of ADC for every accumulator, operand, carry and
+    decimal flag, so the handlers do a single lookup instead of the binary
+    and BCD arithmetic.
+
+    AdcEntry is the reference: it is the arithmetic the ADC handlers used to
+    do, with the flags as SET_ADD_FLAGS set them. The flags are kept in
+    their status register positions.
+*/
+static constexpr Byte ADC_FLAG_C = 0x01;
+static constexpr Byte ADC_FLAG_Z = 0x02;
+static constexpr Byte ADC_FLAG_V = 0x40;
+static constexpr Byte ADC_FLAG_N = 0x80;
+
+struct AdcResult {
+    Byte result;
+    Byte flags;
+};
+
+constexpr AdcResult AdcEntry(Byte v1, Byte v2, Byte c, Byte decimal) {
+    Byte a = 0;
+    Byte carry = 0;
+    if (decimal) {
+        Byte lb1 = (v1&0x0F);
+        Byte lb2 = (v2&0x0F);
+        Byte lb = lb1 + lb2 + c;
+        if (lb > 0x09) {
+            lb += 0x06;
+        }
+        Byte hb1 = (v1&0xF0)>>4;
+        Byte hb2 = (v2&0xF0)>>4;
+        Byte hc = (lb >> 4);
+        Byte hb = hb1 + hb2;
+        if ((hb + hc) > 0x09) {
+            hb += 0x06;
+            carry = 1;
+        }
+        a = (hb << 4) + lb;
+    } else {
+        Word w1 = v1, w2 = v2;
+        w1 = w1 + w2 + c;
+        a = w1 & 0xFF;
+        carry = (w1 & 0x0100) != 0;
+    }
+
+    Byte flags = carry ? ADC_FLAG_C : 0;
+    if (a == 0) {
+        flags |= ADC_FLAG_Z;
+    }
+    if ((v1 < 0x80) && (v2 < 0x80) && ((v1 + v2) >= 0x80)) {
+        flags |= ADC_FLAG_V;
+    }
+    flags |= a & ADC_FLAG_N;
+    return {a, flags};
+}
+
+static_assert(AdcEntry(0x50, 0x50, 0, 0).result == 0xA0 && AdcEntry(0x50, 0x50, 0, 0).flags == (ADC_FLAG_V | ADC_FLAG_N), "");
+static_assert(AdcEntry(0xFF, 0x00, 1, 0).result == 0x00 && AdcEntry(0xFF, 0x00, 1, 0).flags == (ADC_FLAG_C | ADC_FLAG_Z), "");
+static_assert(AdcEntry(0x19, 0x01, 0, 1).result == 0x20, "");
+static_assert(AdcEntry(0x99, 0x01, 0, 1).result == 0x00 && (AdcEntry(0x99, 0x01, 0, 1).flags & ADC_FLAG_C), "");
+
+/*  Index of A + operand + carry in adc_table. */
+constexpr u32 AdcIndex(Byte a, Byte operand, Byte carry, Byte decimal) {
+    return (u32(decimal) << 17) | (u32(carry) << 16) | (u32(a) << 8) | operand;
+}
+
+typedef std::array<AdcResult, 0x40000> AdcTable;
+
+/*  Filled from AdcEntry when the program starts (see cpu.cpp). All 256K
+    entries are too many to evaluate at compile time: that is past clang's
+    default constexpr step limit and takes g++ tens of seconds.
+*/
+extern const AdcTable adc_table;
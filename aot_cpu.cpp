@@ -0,0 +1,255 @@
+#include "aot_cpu.h"
+#include "decode_cache.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+AotCPU::AotCPU(Mem *m, const AotProgram& program) :
+    CPU(m),
+    aot_blocks_run(0),
+    aot_interpreted(0),
+    aot_rejected(0),
+    m_program(program),
+    m_entry(new const AotBlock*[Mem::max_mem_size]()),
+    m_installed(false),
+    m_code_written(false)
+{
+    mem->SetWatcher(this);
+}
+
+AotCPU::~AotCPU() {
+    mem->SetWatcher(nullptr);
+    delete[] m_entry;
+}
+
+void AotCPU::Install() {
+    memset(m_entry, 0, Mem::max_mem_size * sizeof(*m_entry));
+    m_installed = true;
+    for (size_t i = 0; i < m_program.block_count; ++i) {
+        Install(m_program.blocks[i]);
+    }
+}
+
+/*  Whether every byte of [start, end) can be read through the page table. */
+static bool Readable(const Mem& mem, Word start, Word end) {
+    for (Word a = start; a != end; ++a) {
+        if (!mem.ReadPage(a >> 8)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AotCPU::Install(const AotBlock& block) {
+    if (!Readable(*mem, block.start, block.end) || AotHash(*mem, block.start, block.end) != block.hash) {
+        ++aot_rejected;
+        return;
+    }
+    m_entry[block.start] = &block;
+    for (Word a = block.start; a != block.end; ++a) {
+        mem->Watch(a);
+    }
+}
+
+u64 AotCPU::Run(u64 cycle_budget) {
+    if (!m_installed) {
+        Install();
+    }
+
+    u64 cycles = 0;
+    while (cycles < cycle_budget) {
+        const AotBlock* block = m_entry[PC];
+        if (block) {
+            m_code_written = false;
+            block->fn(*this, cycles, cycle_budget);
+            ++aot_blocks_run;
+            continue;
+        }
+
+        DecodedInstruction d = Decode();
+        u32 c = d.cycles + s_dispatch[d.opcode](*this, d.operand);
+        ++aot_interpreted;
+        if (!opcode_info[d.opcode].implemented) {
+            return cycles;
+        }
+        cycles += c;
+    }
+    return cycles;
+}
+
+void AotCPU::OnWrite(Word addr) {
+    m_code_written = true;
+    for (size_t i = 0; i < m_program.block_count; ++i) {
+        const AotBlock& block = m_program.blocks[i];
+        bool covered = block.start <= block.end
+            ? (addr >= block.start && addr < block.end)
+            : (addr >= block.start || addr < block.end);
+        if (covered && m_entry[block.start] == &block) {
+            m_entry[block.start] = nullptr;
+        }
+    }
+}
+
+void AotCPU::OnReload() {
+    m_installed = false;
+}
+
+void AotCPU::OnRemap(Byte first, size_t count) {
+    if (!m_installed) {
+        return;
+    }
+    // a bank switch from translated code ends the block after the store
+    m_code_written = true;
+    for (size_t i = 0; i < m_program.block_count; ++i) {
+        const AotBlock& block = m_program.blocks[i];
+        // a block is at most 768 bytes, so checking where it starts and
+        // each page boundary it crosses finds every page it is on
+        bool remapped = false;
+        for (Word a = block.start; ; a = Word((a | 0xFF) + 1)) {
+            size_t page = a >> 8;
+            remapped |= page >= first && page < first + count;
+            if (Word(block.end - a) <= Word(0x100 - (a & 0xFF))) {
+                break;
+            }
+        }
+        if (remapped) {
+            if (m_entry[block.start] == &block) {
+                m_entry[block.start] = nullptr;
+            }
+            Install(block);
+        }
+    }
+}
+
+u32 AotHash(const Mem& mem, Word start, Word end) {
+    u32 hash = 2166136261u;
+    for (Word a = start; a != end; ++a) {
+        const Byte* page = mem.ReadPage(a >> 8);
+        hash ^= page ? page[a & 0xFF] : 0;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// a block also ends after this many instructions, and the next one starts there
+static constexpr size_t max_block_ops = 256;
+
+static const char* OpcodeName(Byte opcode) {
+    switch (opcode) {
+#define AOT_OPCODE_NAME(name, ...) case INS_##name: return #name;
+        CPU_OPCODES(AOT_OPCODE_NAME)
+#undef AOT_OPCODE_NAME
+        default: return nullptr;
+    }
+}
+
+/*  Whether the instruction may write memory, which may be translated code. */
+static bool WritesMemory(Byte opcode) {
+    const char* name = OpcodeName(opcode);
+    bool store = strncmp(name, "ST", 2) == 0;
+    bool shift = strncmp(name, "LSR", 3) == 0 || strncmp(name, "ASL", 3) == 0
+        || strncmp(name, "ROL", 3) == 0 || strncmp(name, "ROR", 3) == 0;
+    return store || (shift && opcode_info[opcode].mode != AM_ACC);
+}
+
+static void Append(std::string& out, const char* format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    out += line;
+}
+
+std::string AotCompile(Mem& mem, const std::vector<Word>& entry_points, const std::string& name) {
+    // trace: start -> end of every block reachable from the entry points
+    std::map<Word, Word> blocks;
+    std::vector<Word> pending(entry_points);
+    while (!pending.empty()) {
+        Word start = pending.back();
+        pending.pop_back();
+        if (blocks.count(start)) {
+            continue;
+        }
+
+        Word addr = start;
+        for (size_t ops = 0; ; ++ops) {
+            if (ops == max_block_ops) {
+                pending.push_back(addr);
+                break;
+            }
+            DecodedInstruction d = DecodeInstruction(mem, addr);
+            if (!opcode_info[d.opcode].implemented) {
+                break;
+            }
+            addr += d.length;
+            if (d.mode == AM_REL) {
+                Byte r = Byte(d.operand);
+                pending.push_back((r & 0x80) ? Word(addr - (0x100 - r)) : Word(addr + r));
+                pending.push_back(addr);
+                break;
+            }
+        }
+        blocks[start] = addr;
+    }
+
+    std::string tag = "AotRom_" + name;
+    std::string out;
+    Append(out, "// generated by tools/recompile; do not edit\n");
+    Append(out, "#include \"aot_cpu.h\"\n\n");
+    Append(out, "struct %s;\n", tag.c_str());
+
+    for (auto& block : blocks) {
+        if (block.first == block.second) {
+            continue;
+        }
+        Append(out, "\ntemplate<> void AotCPU::Block<%s, 0x%04X>(AotCPU& cpu, u64& cycles, u64 cycle_budget) {\n",
+            tag.c_str(), block.first);
+
+        for (Word addr = block.first; addr != block.second; ) {
+            DecodedInstruction d = DecodeInstruction(mem, addr);
+            Word next = addr + d.length;
+            char operand[8];
+            snprintf(operand, sizeof(operand), d.length == 3 ? "0x%04X" : "0x%02X", d.operand);
+
+            Append(out, "    // %04X %s\n", addr, OpcodeName(d.opcode));
+            if (d.mode == AM_REL) {
+                Append(out, "    cpu.PC = 0x%04X;\n", next);
+                Append(out, "    cycles += %u + cpu.Op_%s(%s);\n", d.cycles, OpcodeName(d.opcode), operand);
+                break;
+            }
+            Append(out, "    cycles += %u + cpu.Op_%s(%s);\n", d.cycles, OpcodeName(d.opcode), operand);
+            if (next == block.second) {
+                Append(out, "    cpu.PC = 0x%04X;\n", next);
+            } else {
+                Append(out, "    if (cycles >= cycle_budget%s) { cpu.PC = 0x%04X; return; }\n",
+                    WritesMemory(d.opcode) ? " || cpu.m_code_written" : "", next);
+            }
+            addr = next;
+        }
+        Append(out, "}\n");
+    }
+
+    std::string table;
+    size_t count = 0;
+    for (auto& block : blocks) {
+        if (block.first == block.second) {
+            continue;
+        }
+        Append(table, "    {0x%04X, 0x%04X, 0x%08Xu, &AotCPU::Block<%s, 0x%04X>},\n",
+            block.first, block.second, AotHash(mem, block.first, block.second), tag.c_str(), block.first);
+        ++count;
+    }
+
+    Append(out, "\nextern const AotProgram %s;\n", name.c_str());
+    if (count == 0) {
+        Append(out, "const AotProgram %s = {nullptr, 0};\n", name.c_str());
+        return out;
+    }
+    Append(out, "\nstatic const AotBlock %s_blocks[] = {\n", name.c_str());
+    out += table;
+    Append(out, "};\n\n");
+    Append(out, "const AotProgram %s = {%s_blocks, %zu};\n", name.c_str(), name.c_str(), count);
+    return out;
+}
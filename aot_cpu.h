@@ -0,0 +1,89 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "cpu.h"
+#include "mem.h"
+
+class AotCPU;
+
+/*  One basic block of a ROM translated ahead of time. */
+struct AotBlock {
+    Word start;
+    Word end;       // address just past the last instruction
+    u32 hash;       // AotHash of the bytes it was translated from
+    void (*fn)(AotCPU& cpu, u64& cycles, u64 cycle_budget);
+};
+
+/*  The blocks of one translated ROM, as defined by the output of AotCompile. */
+struct AotProgram {
+    const AotBlock* blocks;
+    size_t block_count;
+};
+
+/*  CPU execution engine for ROMs translated to C++ ahead of time.
+
+    tools/recompile traces the code reachable from a ROM's entry points and
+    writes a translation unit with one function per basic block (see
+    AotCompile). Each function calls the instruction handlers directly with
+    constant operands, so once compiled with optimizations nothing is
+    fetched, decoded or dispatched.
+
+    A block is only used while memory still holds the bytes it was
+    translated from, as read through the page table: blocks are checked
+    when the engine first runs, after every reload and whenever one of
+    their pages is mapped anew (a bank switch, see MemWatcher::OnRemap),
+    and a write to one of their bytes drops them. Code on a page that has
+    to be read through Mem::ReadByte, such as an I/O page, is never run
+    translated. Any PC without a usable block, including code in RAM or
+    code reached in ways the trace could not see, is interpreted. The
+    engine is the Mem's watcher, so like BlockCPU it cannot share a Mem
+    with a DecodeCache.
+*/
+class AotCPU : public CPU, public MemWatcher {
+public:
+
+    AotCPU(Mem* , const AotProgram& program);
+    ~AotCPU();
+
+    AotCPU(const AotCPU&) = delete;
+    AotCPU& operator=(const AotCPU&) = delete;
+
+    /*  Same contract as CPU::Run, with identical cycle counts. */
+    u64 Run(u64 cycle_budget);
+
+    u64 aot_blocks_run;     // translated blocks entered
+    u64 aot_interpreted;    // instructions run by the interpreter
+    u64 aot_rejected;       // blocks that did not match memory when checked
+
+    void OnWrite(Word addr) override;
+    void OnReload() override;
+    void OnRemap(Byte first, size_t count) override;
+
+    /*  Translated block starting at pc; specialized by the generated code,
+        with Rom a tag type unique to each program.
+    */
+    template<typename Rom, Word pc>
+    static void Block(AotCPU& cpu, u64& cycles, u64 cycle_budget);
+
+private:
+
+    void Install();
+    /*  Makes block usable if memory still matches it. */
+    void Install(const AotBlock& block);
+
+    const AotProgram& m_program;
+    const AotBlock** m_entry;   // usable block starting at each address
+    bool m_installed;
+    bool m_code_written;        // set when a translated byte is written
+};
+
+/*  FNV-1a hash of the bytes [start, end) of mem, read through its page
+    table (see Mem::ReadPage). Bytes on a page without a read pointer hash
+    as zero.
+*/
+u32 AotHash(const Mem& mem, Word start, Word end);
+
+/*  Traces the code reachable from entry_points in mem and returns a C++
+    translation unit defining `const AotProgram name`.
+*/
+std::string AotCompile(Mem& mem, const std::vector<Word>& entry_points, const std::string& name);
@@ -0,0 +1,160 @@
+#include "batch.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "cpu.h"
+#include "machine.h"
+
+namespace {
+
+/*  A job in progress. Its registers are kept here between slices and
+    each slice runs a CPU on the stack, so the Mem is its only allocation.
+*/
+struct Task {
+    size_t job;
+    u64 cycles = 0;
+    Registers regs;
+    std::unique_ptr<Mem> mem;
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task*> tasks;
+
+    Task* PopFront() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return nullptr;
+        }
+        Task* task = tasks.front();
+        tasks.pop_front();
+        return task;
+    }
+
+    Task* PopBack() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return nullptr;
+        }
+        Task* task = tasks.back();
+        tasks.pop_back();
+        return task;
+    }
+
+    void Push(Task* task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+};
+
+}
+
+BatchRunner::BatchRunner(size_t threads) :
+    threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+    quantum(100000),
+    cycles(0),
+    seconds(0),
+    steals(0)
+{
+}
+
+std::vector<BatchResult> BatchRunner::Run(const std::vector<BatchJob>& jobs) {
+    std::vector<BatchResult> results(jobs.size());
+    std::vector<Task> tasks(jobs.size());
+    std::vector<WorkerQueue> queues(threads);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        tasks[i].job = i;
+        queues[i % threads].tasks.push_back(&tasks[i]);
+    }
+
+    std::atomic<size_t> remaining(jobs.size());
+    std::atomic<u64> total_cycles(0);
+    std::atomic<u64> total_steals(0);
+
+    // Runs one slice of task, returning true once the job is done.
+    auto run_slice = [&](Task& task) {
+        const BatchJob& job = jobs[task.job];
+        if (!task.mem) {
+            task.mem.reset(new Mem());
+            task.mem->LoadShared(job.image);
+            task.regs.PC = job.pc;
+            task.regs.A = job.A;
+            task.regs.X = job.X;
+            task.regs.Y = job.Y;
+        }
+        CPU cpu(task.mem.get());
+        task.regs.Store(cpu);
+        u64 budget = std::min(quantum, job.max_cycles - task.cycles);
+        u64 used = cpu.RunUntil(job.stop_pc, budget);
+        task.regs.Load(cpu);
+        task.cycles += used;
+
+        BatchStatus status;
+        if (cpu.PC == job.stop_pc) {
+            status = BATCH_STOPPED;
+        } else if (used < budget) {
+            status = BATCH_UNKNOWN_OPCODE;
+        } else if (task.cycles >= job.max_cycles) {
+            status = BATCH_OUT_OF_CYCLES;
+        } else {
+            return false;
+        }
+        BatchResult& r = results[task.job];
+        r.status = status;
+        r.cycles = task.cycles;
+        r.PC = cpu.PC;
+        r.A = cpu.A;
+        r.X = cpu.X;
+        r.Y = cpu.Y;
+        r.P = cpu.GetStatus();
+        r.result = task.mem->ReadByte(job.result_addr);
+        task.mem.reset();
+        return true;
+    };
+
+    auto worker = [&](size_t self) {
+        u64 my_cycles = 0;
+        u64 my_steals = 0;
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            Task* task = queues[self].PopFront();
+            for (size_t i = 1; !task && i < threads; ++i) {
+                task = queues[(self + i) % threads].PopBack();
+                my_steals += task != nullptr;
+            }
+            if (!task) {
+                // everything left is being run by other workers
+                std::this_thread::yield();
+                continue;
+            }
+            u64 before = task->cycles;
+            bool done = run_slice(*task);
+            my_cycles += task->cycles - before;
+            if (done) {
+                remaining.fetch_sub(1, std::memory_order_release);
+            } else {
+                queues[self].Push(task);
+            }
+        }
+        total_cycles += my_cycles;
+        total_steals += my_steals;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread& t : workers) {
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    cycles = total_cycles;
+    steals = total_steals;
+    seconds = std::chrono::duration<double>(end - start).count();
+    return results;
+}
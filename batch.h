@@ -0,0 +1,59 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "types.h"
+#include "mem.h"
+
+/*  One machine to run: a CPU on a Mem loaded with LoadShared from image,
+    so any number of jobs can share one ROM.
+*/
+struct BatchJob {
+    std::shared_ptr<const MemImage> image;
+    Word pc = 0;
+    Byte A = 0, X = 0, Y = 0;
+    Word stop_pc = 0;           // the job is done once PC gets here
+    u64 max_cycles = ~u64(0);   // or once it has run this many cycles
+    Word result_addr = 0;       // read into BatchResult::result at the end
+};
+
+enum BatchStatus : Byte {
+    BATCH_STOPPED,          // reached stop_pc
+    BATCH_OUT_OF_CYCLES,    // ran max_cycles first
+    BATCH_UNKNOWN_OPCODE,   // hit an opcode the CPU does not know
+};
+
+struct BatchResult {
+    BatchStatus status;
+    u64 cycles;
+    Word PC;
+    Byte A, X, Y, P;
+    Byte result;            // the byte at BatchJob::result_addr
+};
+
+/*  Runs many independent jobs to completion over a set of worker threads.
+
+    Jobs are dealt out to per-worker queues and run in slices of quantum
+    cycles. After each slice an unfinished job goes to the back of its
+    worker's queue. A worker whose queue is empty steals from the back of
+    another's, so long jobs do not hold up short ones queued behind them.
+    A job's Mem is only created when it first runs.
+*/
+class BatchRunner {
+public:
+
+    /*  0 threads means one per core. */
+    explicit BatchRunner(size_t threads = 0);
+
+    /*  Results in the order of jobs. */
+    std::vector<BatchResult> Run(const std::vector<BatchJob>& jobs);
+
+    size_t threads;
+    u64 quantum;            // cycles a job runs before going back in the queue
+
+    // totals for the last Run
+    u64 cycles;
+    double seconds;
+    u64 steals;             // jobs taken from another worker's queue
+
+    double EmulatedMHz() const { return seconds > 0 ? cycles / seconds / 1e6 : 0; }
+};
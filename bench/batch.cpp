@@ -0,0 +1,61 @@
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "../batch.h"
+
+/*  BatchRunner on 2000 jobs of mixed length (about 2K to 460K cycles each,
+    see the loop below), from one thread up to one per core. Reports the
+    aggregate emulated MHz and the speedup over one thread.
+
+    $8000: STX $10      ; count $10 up from X to 0,
+    $8002: CLC          ; with A going through 256 each time round
+           ADC #$01
+           BNE $8002
+           LDA $10
+           ADC #$00
+           STA $10
+           BEQ $8014
+           LDA #$00
+           BEQ $8002
+    $8014:
+*/
+int main() {
+    const Byte program[] = {
+        0x86, 0x10,
+        0x18,
+        0x69, 0x01,
+        0xD0, 0xFB,
+        0xA5, 0x10,
+        0x69, 0x00,
+        0x85, 0x10,
+        0xF0, 0x05,
+        0xA9, 0x00,
+        0xF0, 0xEF,
+    };
+    auto image = std::make_shared<const MemImage>(program, sizeof(program), 0x8000);
+
+    std::vector<BatchJob> jobs(2000);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].image = image;
+        jobs[i].pc = 0x8000;
+        jobs[i].X = Byte(i * 37);
+        jobs[i].stop_pc = 0x8014;
+    }
+
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    printf("%zu cores\n", cores);
+    double single = 0;
+    for (size_t threads = 1; threads <= cores; threads *= 2) {
+        BatchRunner runner(threads);
+        runner.Run(jobs);
+        if (threads == 1) {
+            single = runner.EmulatedMHz();
+        }
+        printf("%2zu threads %10.2f emulated MHz  %5.2fx  %8llu steals\n",
+            threads, runner.EmulatedMHz(), runner.EmulatedMHz() / single, (unsigned long long)runner.steals);
+        if (threads < cores && threads * 2 > cores) {
+            threads = cores / 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include "../types.h"
+
+/*  Program shared by the benchmarks. It only uses implemented opcodes and
+    every path branches back to the start, so it can run for as long as a
+    benchmark needs.
+
+    loop: CLC
+          ADC #$01
+          STA $10
+          LDX $10
+          TXA
+          ASL A
+          LSR A
+          BIT $10
+          BNE loop
+          BEQ loop
+*/
+static constexpr Word bench_origin = 0x8000;
+static constexpr Byte bench_program[] = {
+    0x18,
+    0x69, 0x01,
+    0x85, 0x10,
+    0xA6, 0x10,
+    0x8A,
+    0x0A,
+    0x4A,
+    0x24, 0x10,
+    0xD0, 0xF2,
+    0xF0, 0xF0,
+};
+
+/*  Calls fn() `iterations` times and prints how many calls per second that
+    was. fn returns the number of emulated cycles it ran so the result can
+    also be reported in emulated MHz.
+*/
+template <typename Fn>
+double BenchRate(const char* name, u64 iterations, Fn fn) {
+    u64 cycles = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < iterations; ++i) {
+        cycles += fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = iterations / seconds;
+    printf("%-32s %12.0f /sec  %8.2f emulated MHz\n", name, rate, cycles / seconds / 1e6);
+    return rate;
+}
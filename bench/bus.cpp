@@ -0,0 +1,35 @@
+#include <cstring>
+#include "bench.h"
+#include "../cpu.h"
+#include "../mem.h"
+
+/*  Compares CPU::Run on Mem, whose ReadByte and WriteByte are out of line
+    in mem.cpp, against the same core on FlatBus, a plain 64 KB array whose
+    accesses the compiler inlines into every handler.
+*/
+struct FlatBus {
+    Byte data[Mem::max_mem_size] = {};
+    Byte ReadByte(Word addr) { return data[addr]; }
+    Byte WriteByte(Word addr, Byte v) { return data[addr] = v; }
+    Word ReadWord(Word addr) { return data[addr] | data[Word(addr + 1)] << 8; }
+};
+
+int main() {
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    CPU cpu(&mem);
+    cpu.PC = bench_origin;
+    double run = BenchRate("CPU::Run, Mem", batches, [&] { return cpu.Run(batch_cycles); });
+
+    FlatBus bus;
+    memcpy(bus.data + bench_origin, bench_program, sizeof(bench_program));
+    BasicCPU<Nmos6502, FlatBus> flat(&bus);
+    flat.PC = bench_origin;
+    double inlined = BenchRate("CPU::Run, FlatBus", batches, [&] { return flat.Run(batch_cycles); });
+
+    printf("FlatBus/Mem: %.2fx\n", inlined / run);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "bench.h"
+#include "../cpu.h"
+#include "../cpu_bank.h"
+#include "../mem.h"
+
+/*  CpuBank::Run over 256 lanes sharing one image, each lane starting with
+    a different A, on the SIMD path and with every lane going through the
+    CPU, against 256 CPUs each running on their own with CPU::Run. The
+    emulated MHz are summed over all lanes.
+
+    Once with bench_program, whose STA, LDX and BIT go to memory a lane at
+    a time, and once with a loop that stays in registers:
+
+    loop: CLC
+          ADC #$01
+          TAX
+          ASL A
+          LSR A
+          AND #$7F
+          BNE loop
+          BEQ loop
+*/
+static void Compare(const char* name, const Byte* program, size_t size) {
+    constexpr size_t lanes = 256;
+    constexpr u64 batches = 200;
+    constexpr u64 batch_cycles = 1000;
+
+    auto image = std::make_shared<const MemImage>(program, size, bench_origin);
+    std::vector<std::unique_ptr<Mem>> mems;
+    std::vector<std::unique_ptr<CPU>> cpus;
+    for (size_t i = 0; i < lanes; ++i) {
+        mems.emplace_back(new Mem());
+        mems.back()->LoadShared(image);
+        cpus.emplace_back(new CPU(mems.back().get()));
+        cpus.back()->PC = bench_origin;
+        cpus.back()->A = Byte(i);
+    }
+
+    printf("%s\n", name);
+    double rates[2];
+    for (bool simd : {true, false}) {
+        CpuBank bank(lanes);
+        bank.simd = simd && CpuBank::HasSimd();
+        for (size_t i = 0; i < lanes; ++i) {
+            bank.Load(i, *cpus[i]);
+        }
+        rates[simd] = BenchRate(simd ? "  CpuBank::Run, SIMD" : "  CpuBank::Run, CPU only", batches, [&] {
+            u64 before = std::accumulate(bank.cycles.begin(), bank.cycles.end(), u64(0));
+            bank.Run(batch_cycles);
+            return std::accumulate(bank.cycles.begin(), bank.cycles.end(), u64(0)) - before;
+        });
+        if (simd) {
+            printf("  %.1f%% of instructions on the SIMD path\n",
+                100.0 * bank.simd_steps / (bank.simd_steps + bank.scalar_steps));
+        }
+    }
+    double single = BenchRate("  CPU::Run on each", batches, [&] {
+        u64 cycles = 0;
+        for (auto& cpu : cpus) {
+            cycles += cpu->Run(batch_cycles);
+        }
+        return cycles;
+    });
+    printf("  SIMD/CPU only: %.2fx  SIMD/CPU::Run: %.2fx\n", rates[1] / rates[0], rates[1] / single);
+}
+
+int main() {
+    if (!CpuBank::HasSimd()) {
+        printf("no AVX2 on this host, every lane goes through the CPU\n");
+    }
+    Compare("bench_program", bench_program, sizeof(bench_program));
+
+    const Byte registers[] = {
+        0x18,
+        0x69, 0x01,
+        0xAA,
+        0x0A,
+        0x4A,
+        0x29, 0x7F,
+        0xD0, 0xF6,
+        0xF0, 0xF4,
+    };
+    Compare("register loop", registers, sizeof(registers));
+    return 0;
+}
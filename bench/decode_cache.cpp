@@ -0,0 +1,34 @@
+#include "bench.h"
+#include "../cpu.h"
+#include "../threaded_cpu.h"
+#include "../decode_cache.h"
+#include "../mem.h"
+
+/*  Compares decoding every instruction from memory against serving it
+    from a DecodeCache in CPU::Run, with ThreadedCPU::Run (which ignores
+    the cache) for reference.
+*/
+int main() {
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+
+    CPU cpu(&mem);
+    cpu.PC = bench_origin;
+    double plain = BenchRate("CPU::Run", batches, [&] { return cpu.Run(batch_cycles); });
+
+    DecodeCache cache(&mem);
+    cpu.decode_cache = &cache;
+    cpu.PC = bench_origin;
+    double cached = BenchRate("CPU::Run, decode cache", batches, [&] { return cpu.Run(batch_cycles); });
+
+    ThreadedCPU threaded(&mem);
+    threaded.PC = bench_origin;
+    BenchRate("ThreadedCPU::Run", batches, [&] { return threaded.Run(batch_cycles); });
+
+    printf("decode cache hit rate: %.4f\n", double(cache.hits) / (cache.hits + cache.misses));
+    printf("cached/plain: %.2fx\n", cached / plain);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include "bench.h"
+#include "../cpu.h"
+#include "../mem.h"
+
+/*  Compares the handler table used by CPU::RunOneInstruction against the
+    switch in CPU::RunOneInstructionSwitch on the same program.
+*/
+int main() {
+    constexpr u64 instructions = 50000000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    CPU cpu(&mem);
+
+    cpu.PC = bench_origin;
+    double sw = BenchRate("switch dispatch", instructions, [&] { return cpu.RunOneInstructionSwitch(); });
+
+    cpu.PC = bench_origin;
+    double table = BenchRate("table dispatch", instructions, [&] { return cpu.RunOneInstruction(); });
+
+    printf("table/switch: %.2fx\n", table / sw);
+    return 0;
+}
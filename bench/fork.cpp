@@ -0,0 +1,75 @@
+#include <memory>
+#include <vector>
+#include "bench.h"
+#include "../cpu.h"
+#include "../machine.h"
+#include "../mem.h"
+
+/*  Branching a machine state as a tree search would: take a child of the
+    parent, run it for a few hundred cycles and throw it away. Mem::Fork
+    and reusing one child with ForkFrom, against copying all 64 KB into a
+    Mem with LoadFromData or copying a whole Machine. bench_program only
+    writes the zero page, so a child copies one page.
+
+    The parent holds either just the zero page or 128 written pages, as
+    the fork takes a reference on each of them.
+*/
+static void Compare(size_t written) {
+    constexpr u64 forks = 50000;
+    constexpr u64 child_cycles = 300;
+
+    Mem parent;
+    parent.LoadSparse(bench_program, sizeof(bench_program), bench_origin);
+    for (size_t page = 0; page < written; ++page) {
+        parent.WriteByte(Word(page * Mem::page_size), 1);
+    }
+    CPU cpu(&parent);
+    cpu.PC = bench_origin;
+    cpu.Run(1000);
+    printf("parent holding %zu pages\n", parent.PrivatePageCount());
+
+    double fork = BenchRate("  Mem::Fork", forks, [&] {
+        auto child = parent.Fork();
+        CPU branch = cpu;
+        branch.mem = child.get();
+        return branch.Run(child_cycles);
+    });
+
+    Mem reused;
+    double fork_from = BenchRate("  Mem::ForkFrom, one Mem", forks, [&] {
+        reused.ForkFrom(parent);
+        CPU branch = cpu;
+        branch.mem = &reused;
+        return branch.Run(child_cycles);
+    });
+
+    std::vector<Byte> flat(Mem::max_mem_size);
+    for (size_t addr = 0; addr < flat.size(); ++addr) {
+        flat[addr] = parent.ReadByte(Word(addr));
+    }
+    Mem copied;
+    double load = BenchRate("  Mem::LoadFromData, one Mem", forks, [&] {
+        copied.LoadFromData(flat.data(), flat.size());
+        CPU branch = cpu;
+        branch.mem = &copied;
+        return branch.Run(child_cycles);
+    });
+
+    Machine machine;
+    machine.LoadFromData(flat.data(), flat.size());
+    machine.Load(cpu);
+    Machine child;
+    double copy = BenchRate("  Machine copy", forks, [&] {
+        child = machine;
+        return child.Run(child_cycles);
+    });
+
+    printf("  Fork/LoadFromData: %.2fx  ForkFrom/LoadFromData: %.2fx  ForkFrom/Machine copy: %.2fx\n",
+        fork / load, fork_from / load, fork_from / copy);
+}
+
+int main() {
+    Compare(1);
+    Compare(128);
+    return 0;
+}
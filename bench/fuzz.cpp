@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "bench.h"
+#include "../cpu.h"
+#include "../fuzz.h"
+#include "../mem.h"
+
+/*  Fuzz executions per second on a small input checker (the program in
+    test/cpu/fuzz.h) with random 4 byte inputs:
+
+    - a new Mem and CPU per input, reloading the ROM with LoadFromFile
+    - Fuzzer::Run in process, restoring dirty pages between inputs
+    - fork() per input from a loaded Fuzzer, as the fork server does
+      without persistent mode
+*/
+int main() {
+    const char* path = "bench_fuzz.bin";
+    const Byte code[] = {
+        0xA2, 0x00, 0x18, 0xBD, 0x00, 0x02, 0x7D, 0x20, 0x80, 0xD0, 0x0A,
+        0x8A, 0x18, 0x69, 0x01, 0xAA, 0x29, 0x04, 0xF0, 0xEE, 0x02, 0xD0, 0xFE,
+    };
+    std::vector<Byte> rom(Mem::max_mem_size);
+    memcpy(rom.data() + 0x8000, code, sizeof(code));
+    const Byte magic[] = { 0xBA, 0xAB, 0xA6, 0xDF };
+    memcpy(rom.data() + 0x8020, magic, sizeof(magic));
+    FILE* file = fopen(path, "wb");
+    fwrite(rom.data(), 1, rom.size(), file);
+    fclose(file);
+
+    FuzzConfig config;
+    config.entry = 0x8000;
+    config.stop_pc = 0x8015;
+
+    std::mt19937 random(6502);
+    Byte input[4];
+    auto mutate = [&] {
+        // keep "F" so runs go past the first check now and then
+        for (Byte& b : input) {
+            b = Byte(random());
+        }
+        input[0] = random() & 1 ? 'F' : input[0];
+    };
+
+    constexpr u64 execs = 20000;
+    double reload = BenchRate("new Mem + LoadFromFile", execs, [&] {
+        mutate();
+        Mem mem;
+        mem.LoadFromFile(path);
+        for (size_t i = 0; i < sizeof(input); ++i) {
+            mem.WriteByte(Word(config.input_addr + i), input[i]);
+        }
+        CPU cpu(&mem);
+        cpu.PC = config.entry;
+        return cpu.RunUntil(config.stop_pc, config.max_cycles);
+    });
+
+    Fuzzer fuzzer(config);
+    fuzzer.LoadFromFile(path);
+    double persistent = BenchRate("Fuzzer::Run", execs * 5, [&] {
+        mutate();
+        fuzzer.Run(input, sizeof(input));
+        return fuzzer.cycles;
+    });
+
+    double forked = BenchRate("fork, Fuzzer::Run", execs / 4, [&] {
+        mutate();
+        pid_t child = fork();
+        if (child == 0) {
+            fuzzer.Run(input, sizeof(input));
+            _exit(0);
+        }
+        int status;
+        waitpid(child, &status, 0);
+        return u64(0);
+    });
+
+    printf("Fuzzer::Run/LoadFromFile: %.2fx  fork/LoadFromFile: %.2fx\n",
+        persistent / reload, forked / reload);
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+#include "../cpu.h"
+#include "../block_cpu.h"
+#include "../jit_cpu.h"
+#include "../mem.h"
+
+/*  Compares CPU::Run, BlockCPU::Run and JitCPU::Run on the bench program,
+    which the JIT translates completely.
+*/
+int main() {
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    CPU cpu(&mem);
+    cpu.PC = bench_origin;
+    double run = BenchRate("CPU::Run", batches, [&] { return cpu.Run(batch_cycles); });
+
+    Mem block_mem;
+    block_mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    BlockCPU block(&block_mem);
+    block.PC = bench_origin;
+    double blk = BenchRate("BlockCPU::Run", batches, [&] { return block.Run(batch_cycles); });
+
+    Mem jit_mem;
+    jit_mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    JitCPU jit(&jit_mem);
+    jit.PC = bench_origin;
+    double jt = BenchRate("JitCPU::Run", batches, [&] { return jit.Run(batch_cycles); });
+    printf("jit compiled: %llu executed: %llu interpreted: %llu\n",
+        (unsigned long long)jit.jit_compiled, (unsigned long long)jit.jit_executed,
+        (unsigned long long)jit.jit_interpreted);
+
+    printf("block/Run: %.2fx  jit/Run: %.2fx\n", blk / run, jt / run);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "bench.h"
+#include "../mem.h"
+
+/*  Compares reloading a ROM image with Mem::LoadFromFile, which copies the
+    whole file, against Mem::MapFromFile, which maps it copy-on-write, for
+    a full 64 KB image and a 16 KB one. Each reload then touches either one
+    page or every 4 KB page, as a short or a long run would. Then creates a
+    Mem per load, as a batch of short runs does, with and without a
+    MemArena to hand the backing store from one to the next.
+*/
+int main() {
+    constexpr u64 reloads = 20000;
+    const char* path = "bench_load.bin";
+
+    Byte image[Mem::max_mem_size];
+    for (size_t i = 0; i < sizeof(image); ++i) {
+        image[i] = Byte(i * 7);
+    }
+
+    Mem mem;
+    for (size_t size : {sizeof(image), size_t(0x4000)}) {
+        FILE* file = fopen(path, "wb");
+        fwrite(image, 1, size, file);
+        fclose(file);
+        printf("%zu KB image\n", size / 1024);
+
+        for (Word stride : {Word(0), Word(0x1000)}) {
+            auto touch = [&] {
+                u64 sum = mem.ReadByte(bench_origin);
+                for (u32 addr = stride; stride && addr < Mem::max_mem_size; addr += stride) {
+                    sum += mem.ReadByte(addr);
+                }
+                return sum & 0;
+            };
+            const char* pages = stride ? "all pages" : "one page";
+            char name[64];
+            snprintf(name, sizeof(name), "LoadFromFile, %s", pages);
+            double load = BenchRate(name, reloads, [&] { mem.LoadFromFile(path); return touch(); });
+            snprintf(name, sizeof(name), "MapFromFile, %s", pages);
+            double map = BenchRate(name, reloads, [&] { mem.MapFromFile(path); return touch(); });
+            printf("map/load: %.2fx\n", map / load);
+        }
+    }
+    remove(path);
+
+    constexpr size_t program_size = sizeof(bench_program);
+    BenchRate("new Mem per load", reloads, [&] {
+        Mem fresh;
+        fresh.LoadFromDataAtOffset(bench_program, program_size, bench_origin);
+        return fresh.ReadByte(bench_origin) & 0;
+    });
+    MemArena arena;
+    BenchRate("new Mem per load, arena", reloads, [&] {
+        Mem fresh(&arena);
+        fresh.LoadFromDataAtOffset(bench_program, program_size, bench_origin);
+        return fresh.ReadByte(bench_origin) & 0;
+    });
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <memory>
+#include <vector>
+#include "bench.h"
+#include "../cpu.h"
+#include "../machine.h"
+#include "../mem.h"
+
+/*  Cloning a machine mid-run: copying a Machine, against rebuilding a Mem
+    and CPU with the same memory and registers, by copying the memory in
+    with LoadFromData or sharing an image with LoadShared. Then CPU::Run on
+    a Mem against Machine::Run on the same program.
+*/
+int main() {
+    constexpr u64 clones = 100000;
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Machine machine;
+    machine.LoadFromData(bench_program, sizeof(bench_program), bench_origin);
+    machine.PC = bench_origin;
+    machine.Run(1000);
+
+    // a few targets, so each copy lands somewhere the next one does not
+    // overwrite straight away
+    std::vector<Machine> copies(8);
+    size_t next = 0;
+    double copy = BenchRate("Machine copy", clones, [&] {
+        copies[next++ % copies.size()] = machine;
+        return 0;
+    });
+    for (const Machine& m : copies) {
+        if (m.ram[bench_origin] != bench_program[0]) {
+            printf("bad copy\n");
+        }
+    }
+
+    double rebuild = BenchRate("new Mem + CPU, LoadFromData", clones, [&] {
+        Mem mem;
+        mem.LoadFromData(machine.ram, sizeof(machine.ram));
+        CPU cpu(&mem);
+        machine.Store(cpu);
+        return 0;
+    });
+
+    auto image = std::make_shared<const MemImage>(machine.ram, sizeof(machine.ram));
+    double shared = BenchRate("new Mem + CPU, LoadShared", clones, [&] {
+        Mem mem;
+        mem.LoadShared(image);
+        CPU cpu(&mem);
+        machine.Store(cpu);
+        return 0;
+    });
+    printf("copy/LoadFromData: %.2fx  copy/LoadShared: %.2fx\n", copy / rebuild, copy / shared);
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    CPU cpu(&mem);
+    cpu.PC = bench_origin;
+    double run = BenchRate("CPU::Run, Mem", batches, [&] { return cpu.Run(batch_cycles); });
+    double inlined = BenchRate("Machine::Run", batches, [&] { return machine.Run(batch_cycles); });
+    printf("Machine/Mem: %.2fx\n", inlined / run);
+    return 0;
+}
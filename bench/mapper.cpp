@@ -0,0 +1,76 @@
+#include <vector>
+#include "bench.h"
+#include "../cpu.h"
+#include "../mem.h"
+#include "../mapper.h"
+
+/*  Bank switching through the mappers in mapper.h: raw bank switches
+    through Mem::WriteByte, then CPU::Run on a loop in the fixed UxROM bank
+    that switches the $8000 bank on every iteration and reads from it,
+    against the same loop storing to RAM instead.
+
+    loop: CLC
+          ADC #$01
+          AND #$07
+          STA $8000     ; or $0200
+          LDX $8000
+          BNE loop
+          BEQ loop
+*/
+int main() {
+    constexpr u64 switches = 2000000;
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+    constexpr Word origin = 0xC000;
+
+    std::vector<Byte> prg(8 * 0x4000);
+    for (size_t i = 0; i < prg.size(); ++i) {
+        prg[i] = Byte(i / 0x4000);
+    }
+    const Byte program[] = {
+        0x18,
+        0x69, 0x01,
+        0x29, 0x07,
+        0x8D, 0x00, 0x80,
+        0xAE, 0x00, 0x80,
+        0xD0, 0xF3,
+        0xF0, 0xF1,
+    };
+    Byte* fixed = prg.data() + prg.size() - 0x4000;
+    std::copy(program, program + sizeof(program), fixed);
+
+    Mem mem;
+    mem.LoadFromData(prg.data(), 0);
+    u64 bank = 0;
+
+    auto uxrom = Mapper::Create(2, prg.data(), prg.size());
+    uxrom->Attach(&mem);
+    BenchRate("UxROM switch", switches, [&] { mem.WriteByte(0x8000, Byte(++bank)); return 0; });
+
+    auto mmc1 = Mapper::Create(1, prg.data(), prg.size());
+    mmc1->Attach(&mem);
+    BenchRate("MMC1 switch (5 writes)", switches, [&] {
+        ++bank;
+        for (int bit = 0; bit < 5; ++bit) {
+            mem.WriteByte(0xE000, Byte(bank >> bit) & 1);
+        }
+        return 0;
+    });
+
+    uxrom->Attach(&mem);
+    CPU cpu(&mem);
+    cpu.PC = origin;
+    double switching = BenchRate("CPU::Run, switching banks", batches, [&] { return cpu.Run(batch_cycles); });
+
+    // same loop storing to RAM, so the bank never changes
+    std::vector<Byte> ram_prg(prg);
+    ram_prg[ram_prg.size() - 0x4000 + 6] = 0x02;
+    ram_prg[ram_prg.size() - 0x4000 + 7] = 0x02;
+    auto ram_mapper = Mapper::Create(2, ram_prg.data(), ram_prg.size());
+    ram_mapper->Attach(&mem);
+    cpu.PC = origin;
+    double fixed_bank = BenchRate("CPU::Run, storing to RAM", batches, [&] { return cpu.Run(batch_cycles); });
+
+    printf("switching/RAM: %.2fx\n", switching / fixed_bank);
+    return 0;
+}
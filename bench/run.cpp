@@ -0,0 +1,46 @@
+#include "bench.h"
+#include "../cpu.h"
+#include "../threaded_cpu.h"
+#include "../block_cpu.h"
+#include "../mem.h"
+
+/*  Compares stepping with RunOneInstruction against the batched
+    CPU::Run, ThreadedCPU::Run and BlockCPU::Run, each given the same cycle
+    budget per call.
+*/
+int main() {
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+
+    CPU cpu(&mem);
+    cpu.PC = bench_origin;
+    double step = BenchRate("RunOneInstruction loop", batches, [&] {
+        u64 cycles = 0;
+        while (cycles < batch_cycles) {
+            cycles += cpu.RunOneInstruction();
+        }
+        return cycles;
+    });
+
+    cpu.PC = bench_origin;
+    double run = BenchRate("CPU::Run", batches, [&] { return cpu.Run(batch_cycles); });
+
+    ThreadedCPU threaded(&mem);
+    threaded.PC = bench_origin;
+    double thr = BenchRate("ThreadedCPU::Run", batches, [&] { return threaded.Run(batch_cycles); });
+
+    Mem block_mem;
+    block_mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    BlockCPU block(&block_mem);
+    block.PC = bench_origin;
+    double blk = BenchRate("BlockCPU::Run", batches, [&] { return block.Run(batch_cycles); });
+    printf("block hits: %llu misses: %llu chained: %llu\n",
+        (unsigned long long)block.block_hits, (unsigned long long)block.block_misses,
+        (unsigned long long)block.block_chains);
+
+    printf("Run/step: %.2fx  threaded/step: %.2fx  block/step: %.2fx\n", run / step, thr / step, blk / step);
+    return 0;
+}
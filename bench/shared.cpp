@@ -0,0 +1,73 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "bench.h"
+#include "../cpu.h"
+#include "../mem.h"
+
+/*  Runs the benchmark program on many live Mem instances at once, loaded
+    with LoadSparse, with LoadShared from one MemImage, and each with its
+    own copy of the image from LoadFromData. Reports the resident memory
+    each instance adds and how fast the instances run. Sparse memory is
+    also run at ten times the instance count to show it scales.
+*/
+static double ResidentKB() {
+    long pages = 0, resident = 0;
+    if (FILE* statm = fopen("/proc/self/statm", "r")) {
+        if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024.0);
+}
+
+enum Load { SPARSE, SHARED, PRIVATE };
+
+int main() {
+    constexpr u64 run_cycles = 1000;
+
+    Byte image[Mem::max_mem_size] = {};
+    memcpy(image + bench_origin, bench_program, sizeof(bench_program));
+    auto shared = std::make_shared<const MemImage>(image, sizeof(image));
+
+    struct { Load load; size_t instances; const char* name; } runs[] = {
+        { SPARSE, 10000, "LoadSparse, 10K instances" },
+        { SPARSE, 100000, "LoadSparse, 100K instances" },
+        { SHARED, 10000, "LoadShared, 10K instances" },
+        { PRIVATE, 10000, "LoadFromData, 10K instances" },
+    };
+
+    printf("sizeof(Mem): %zu\n", sizeof(Mem));
+    for (const auto& run : runs) {
+        double before = ResidentKB();
+        std::vector<std::unique_ptr<Mem>> mems;
+        for (size_t i = 0; i < run.instances; ++i) {
+            mems.emplace_back(new Mem());
+            switch (run.load) {
+            case SPARSE: mems.back()->LoadSparse(bench_program, sizeof(bench_program), bench_origin); break;
+            case SHARED: mems.back()->LoadShared(shared); break;
+            case PRIVATE: mems.back()->LoadFromData(image, sizeof(image)); break;
+            }
+        }
+        double per_instance = (ResidentKB() - before) / run.instances;
+        size_t next = 0;
+        BenchRate(run.name, 100000, [&] {
+            CPU cpu(mems[next].get());
+            cpu.PC = bench_origin;
+            next = (next + 1) % run.instances;
+            return cpu.Run(run_cycles);
+        });
+        printf("  %.1f KB per instance\n", per_instance);
+        mems.clear();
+#ifdef __GLIBC__
+        // hand the freed instances back, so the next run is measured from scratch
+        malloc_trim(0);
+#endif
+    }
+    return 0;
+}
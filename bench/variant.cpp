@@ -0,0 +1,28 @@
+#include "bench.h"
+#include "../cpu.h"
+#include "../mem.h"
+
+#ifndef VARIANT
+#define VARIANT Nmos6502
+#endif
+
+/*  CPU::Run for one CPU variant, picked with -DVARIANT=<policy> (see the
+    bench-variant-% targets), with the decimal flag clear and set.
+*/
+int main() {
+    constexpr u64 batches = 20000;
+    constexpr u64 batch_cycles = 10000;
+
+    Mem mem;
+    mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+    BasicCPU<VARIANT> cpu(&mem);
+    printf("variant %s\n", VARIANT::name);
+
+    cpu.PC = bench_origin;
+    BenchRate("Run", batches, [&] { return cpu.Run(batch_cycles); });
+
+    cpu.PC = bench_origin;
+    cpu.DecimalMode = 1;
+    BenchRate("Run, decimal flag set", batches, [&] { return cpu.Run(batch_cycles); });
+    return 0;
+}
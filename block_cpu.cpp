@@ -0,0 +1,194 @@
+#include "block_cpu.h"
+#include "decode_cache.h"
+#include <cstring>
+
+// longest run of instructions put into one block
+static constexpr size_t max_block_ops = 64;
+
+BlockCPU::BlockCPU(Mem *m) :
+    CPU(m),
+    block_hits(0),
+    block_misses(0),
+    block_chains(0)
+{
+    memset(m_pages, 0, sizeof(m_pages));
+    mem->SetWatcher(this);
+}
+
+BlockCPU::~BlockCPU() {
+    mem->SetWatcher(nullptr);
+    Flush();
+}
+
+void BlockCPU::Flush() {
+    for (auto& page : m_pages) {
+        delete[] page;
+        page = nullptr;
+    }
+    for (auto& blocks : m_code) {
+        blocks.clear();
+    }
+    m_blocks.clear();
+    m_free.clear();
+}
+
+BlockCPU::Block* BlockCPU::Translate(Word pc) {
+    ++block_misses;
+
+    Block* block;
+    if (m_free.empty()) {
+        m_blocks.push_back(std::make_unique<Block>());
+        block = m_blocks.back().get();
+    } else {
+        block = m_free.back();
+        m_free.pop_back();
+        block->ops.clear();
+    }
+    block->start = pc;
+    block->valid = true;
+    block->exit_block[0] = block->exit_block[1] = nullptr;
+
+    Word addr = pc;
+    while (block->ops.size() < max_block_ops) {
+        DecodedInstruction d = DecodeInstruction(*mem, addr);
+        if (!opcode_info[d.opcode].implemented) {
+            if (block->ops.empty()) {
+                // left for CPU::RunOneInstruction to report, and covering
+                // the instruction so that code written there drops it
+                for (Byte i = 0; i < d.length; ++i) {
+                    mem->Watch(addr + i);
+                }
+                addr += d.length;
+            }
+            break;
+        }
+        block->ops.push_back(MicroOp{ s_dispatch[d.opcode], d.operand, d.length, d.cycles });
+        for (Byte i = 0; i < d.length; ++i) {
+            mem->Watch(addr + i);
+        }
+        addr += d.length;
+        if (d.mode == AM_REL) {
+            break;
+        }
+    }
+    block->end = addr;
+
+    Block**& page = m_pages[pc >> 8];
+    if (!page) {
+        page = new Block*[0x100]();
+    }
+    page[pc & 0xFF] = block;
+    // a block is shorter than a page, so it is on at most two
+    m_code[pc >> 8].push_back(block);
+    if (Byte(Word(addr - 1) >> 8) != Byte(pc >> 8)) {
+        m_code[Word(addr - 1) >> 8].push_back(block);
+    }
+    return block;
+}
+
+inline BlockCPU::Block* BlockCPU::Lookup(Word pc) {
+    Block** page = m_pages[pc >> 8];
+    if (page && page[pc & 0xFF]) {
+        ++block_hits;
+        return page[pc & 0xFF];
+    }
+    return Translate(pc);
+}
+
+inline BlockCPU::Block* BlockCPU::Next(Block* from) {
+    int slot = PC == from->end ? 0 : 1;
+    Block* next = from->exit_block[slot];
+    if (next && next->valid && next->start == PC) {
+        ++block_hits;
+        ++block_chains;
+        return next;
+    }
+    next = Lookup(PC);
+    if (from->valid) {
+        from->exit_block[slot] = next;
+    }
+    return next;
+}
+
+u64 BlockCPU::Run(u64 cycle_budget) {
+    u64 cycles = 0;
+    if (cycles >= cycle_budget) {
+        return cycles;
+    }
+
+    Block* block = Lookup(PC);
+    for (;;) {
+        if (block->ops.empty()) {
+            // unknown opcode at the start of the block, unless it has been
+            // written over since
+            u32 c = CPU::RunOneInstruction();
+            if (c == 0) {
+                return cycles;
+            }
+            cycles += c;
+            if (cycles >= cycle_budget) {
+                return cycles;
+            }
+            block = Lookup(PC);
+            continue;
+        }
+        for (const MicroOp& op : block->ops) {
+            PC += op.length;
+            cycles += op.cycles + op.handler(*this, op.operand);
+            if (cycles >= cycle_budget) {
+                return cycles;
+            }
+            if (!block->valid) {
+                // the block wrote over its own code
+                break;
+            }
+        }
+        block = block->valid ? Next(block) : Lookup(PC);
+    }
+}
+
+void BlockCPU::Drop(Block* block) {
+    // the block may be running, so it is only reused by the next Translate
+    block->valid = false;
+    m_pages[block->start >> 8][block->start & 0xFF] = nullptr;
+    Byte pages[2] = { Byte(block->start >> 8), Byte(Word(block->end - 1) >> 8) };
+    for (Byte page : pages) {
+        std::vector<Block*>& blocks = m_code[page];
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (blocks[i] == block) {
+                blocks[i] = blocks.back();
+                blocks.pop_back();
+                break;
+            }
+        }
+    }
+    m_free.push_back(block);
+}
+
+void BlockCPU::OnWrite(Word addr) {
+    std::vector<Block*>& blocks = m_code[addr >> 8];
+    for (size_t i = 0; i < blocks.size(); ) {
+        Block* block = blocks[i];
+        bool covered = block->start <= block->end
+            ? (addr >= block->start && addr < block->end)
+            : (addr >= block->start || addr < block->end);
+        if (covered) {
+            // takes it out of blocks
+            Drop(block);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void BlockCPU::OnRemap(Byte first, size_t count) {
+    for (size_t page = first; page < first + count; ++page) {
+        while (!m_code[page].empty()) {
+            Drop(m_code[page].back());
+        }
+    }
+}
+
+void BlockCPU::OnReload() {
+    Flush();
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "cpu.h"
+#include "mem.h"
+
+/*  CPU execution engine that translates straight-line code into blocks.
+
+    A block starts at some PC and runs up to and including the next branch
+    (or the next unknown opcode). Its instructions are decoded once into
+    micro-ops holding the handler, operand and cycle count, and the whole
+    block then runs without any fetching or decoding. When a block exits,
+    the successor block is remembered on it, so the next time the same exit
+    is taken execution chains straight into that block.
+
+    Blocks watch the memory they were decoded from; a write to one of
+    their bytes, or mapping one of their pages anew, drops them and they
+    are translated again on the next run.
+    The engine is the Mem's watcher, so it cannot be combined with a
+    DecodeCache on the same Mem and ignores decode_cache.
+*/
+class BlockCPU : public CPU, public MemWatcher {
+public:
+
+    BlockCPU(Mem* );
+    ~BlockCPU();
+
+    BlockCPU(const BlockCPU&) = delete;
+    BlockCPU& operator=(const BlockCPU&) = delete;
+
+    /*  Same contract as CPU::Run, with identical cycle counts. */
+    u64 Run(u64 cycle_budget);
+
+    /*  Drops every translated block. */
+    void Flush();
+
+    u64 block_hits;     // block found already translated
+    u64 block_misses;   // block had to be translated
+    u64 block_chains;   // hits that followed a link from the previous block
+
+    void OnWrite(Word addr) override;
+    void OnReload() override;
+    void OnRemap(Byte first, size_t count) override;
+
+private:
+
+    struct MicroOp {
+        OpHandler handler;
+        Word operand;
+        Byte length;
+        Byte cycles;
+    };
+
+    struct Block {
+        Word start;
+        Word end;       // address just past the last instruction
+        bool valid;
+        std::vector<MicroOp> ops;
+
+        // successors this block has exited to: [0] falls through to end,
+        // [1] the last other exit (a taken branch). A link is only
+        // followed while the block it points at is valid and starts at
+        // the new PC, as dropped blocks are reused.
+        Block* exit_block[2];
+    };
+
+    Block* Lookup(Word pc);
+    Block* Translate(Word pc);
+    Block* Next(Block* from);
+    void Drop(Block* block);
+
+    // every block is owned here, valid or not; dropped ones wait in
+    // m_free to be translated into again
+    std::vector<std::unique_ptr<Block>> m_blocks;
+    std::vector<Block*> m_free;
+    // valid blocks by start address
+    Block** m_pages[0x100];
+    // valid blocks with code on each page, so a write only checks those
+    std::vector<Block*> m_code[0x100];
+};
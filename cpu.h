@@ -1,17 +1,43 @@
 #pragma once
+#include <array>
+#include <type_traits>
 #include "types.h"
+#include "opcodes.h"
+#include "cpu_variant.h"
 class Mem;
+class DecodeCache;
+struct DecodedInstruction;
 
-class CPU {
+/*  The CPU core, templated on a variant policy from cpu_variant.h that
+    picks the decimal mode, cycle quirks and opcode set at compile time.
+    CPU is the NMOS 6502 and is what every other engine builds on.
+
+    Memory is accessed through Bus, Mem by default. Any class with
+        Byte ReadByte(Word addr);
+        Byte WriteByte(Word addr, Byte data);
+        Word ReadWord(Word addr);
+    can be used instead, and when those are defined inline in the class
+    they are inlined into every handler. Only a Mem bus uses decode_cache
+    and the zero page shortcut.
+*/
+template <typename Variant, typename Bus = Mem>
+class BasicCPU {
 public:
 
-    CPU(Mem* );
-    ~CPU();
-    Mem* mem;
+    BasicCPU(Bus* );
+    // Inline so the local copy in RunUntil never has its address taken.
+    ~BasicCPU() = default;
+    Bus* mem;
     Byte A, X, Y;
     Byte SP;
     Word PC;
 
+    /*  Carry, Zero, Overflow and Negative are evaluated lazily: instructions
+        only record the values a flag is derived from (see the m_ fields
+        below) and the flag is worked out when something reads it. Most
+        flag results are overwritten before anything looks at them.
+    */
+
     /*  The carry flag is set if the last operation caused an 
         overflow from bit 7 of the result or an underflow from
         bit 0. This condition is set during arithmetic, 
@@ -19,10 +45,12 @@ public:
         explicitly set using the 'Set Carry Flag' (SEC) 
         instruction and cleared with 'Clear Carry Flag' (CLC). 
     */
-    Byte Carry   : 1;
+    Byte GetCarry() const { return (m_carry >> 8) & 1; }
+    void SetCarry(Byte v) { m_carry = v ? 0x100 : 0; }
 
     /* The zero flag is set if the result of the last operation as was zero. */
-    Byte Zero   : 1;
+    Byte GetZero() const { return m_zero == 0; }
+    void SetZero(Byte v) { m_zero = !v; }
 
     /*  The interrupt disable flag is set if the program has executed a 
         'Set Interrupt Disable' (SEI) instruction. While this flag is set the 
@@ -47,15 +75,130 @@ public:
         and ending up with a negative result: 64 + 64 => -128). It is determined
         by looking at the carry between bits 6 and 7 and between bit 7 and the carry flag.
     */
-    Byte Overflow : 1;
+    Byte GetOverflow() const { return m_overflow >> 6; }
+    void SetOverflow(Byte v) { m_overflow = v ? 0x40 : 0; }
 
     /*  The negative flag is set if the result of the last operation had bit 7 set to a one. */
-    Byte Negative : 1;
+    Byte GetNegative() const { return m_negative >> 7; }
+    void SetNegative(Byte v) { m_negative = v ? 0x80 : 0; }
+
+    /*  All flags packed as the status register, as PHP would push it:
+        NV1B DIZC.
+    */
+    Byte GetStatus() const;
+    void SetStatus(Byte p);
+
+    /*  When set, instructions are decoded once through this cache instead
+        of being fetched and decoded from memory every time they run. The
+        cache is owned by the caller and must be built on the same Mem.
+        It decodes with the NMOS opcode table, so the 65C02 ignores it.
+        ThreadedCPU, which decodes faster without it, ignores it too.
+    */
+    DecodeCache* decode_cache;
 
     u32 RunOneInstruction();
 
+    /*  Same as RunOneInstruction but dispatches through a switch over the
+        opcode instead of the handler table. Kept as the reference the
+        dispatch benchmark compares against.
+    */
+    u32 RunOneInstructionSwitch();
+
+    /*  Runs instructions until at least cycle_budget cycles have been used
+        or an unknown opcode is hit, and returns the cycles actually used.
+        The last instruction may take the total slightly past the budget.
+    */
+    u64 Run(u64 cycle_budget);
+
+    /*  Like Run, but also stops before executing the instruction at
+        stop_pc. Returns straight away if PC is already stop_pc.
+    */
+    u64 RunUntil(Word stop_pc, u64 cycle_budget = ~u64(0));
+
+    /*  Like Run, but also stops before the next instruction once
+        stop(const BasicCPU&) returns true. The predicate is inlined into the
+        run loop.
+    */
+    template <typename Stop>
+    u64 RunUntil(Stop stop, u64 cycle_budget = ~u64(0));
+
     void Reset();
     
+protected:
+
+    /*  Lazy flag state. C is bit 8 of m_carry, which ADC sets to its 9 bit
+        sum. Z is set when m_zero is 0 and N is bit 7 of m_negative, both
+        usually the last result. V is not lazy: m_overflow holds it as
+        bit 6, where ADC's flags and BIT's operand already have it.
+    */
+    Word m_carry;
+    Byte m_zero;
+    Byte m_negative;
+    Byte m_overflow;
+
+    /*  One handler per implemented opcode (see CPU_OPCODES in opcodes.h).
+        Each handler is entered with PC pointing past the whole instruction
+        and its operand already fetched (0 when the mode has none). It
+        returns the cycles the instruction took on top of its base cycles.
+    */
+#define CPU_DECLARE_OPCODE(name, ...) u32 Op_##name(Word operand);
+    CPU_OPCODES(CPU_DECLARE_OPCODE)
+    CPU_OPCODES_65C02(CPU_DECLARE_OPCODE)
+#undef CPU_DECLARE_OPCODE
+
+    /*  Handler for every opcode that is not in CPU_OPCODES. Kept out of
+        the run loops, which only reach it once at the end of a run.
+    */
+    [[gnu::noinline]] u32 Op_Unknown(Word operand);
+
+    /*  Decoding information for this variant's opcodes. */
+    static constexpr const OpcodeTable& Opcodes() {
+        return Variant::cmos_opcodes ? opcode_info_65c02 : opcode_info;
+    }
+
+    /*  Fetches the instruction at PC, from decode_cache when there is one,
+        and moves PC past it.
+    */
+    DecodedInstruction Decode();
+
+    static constexpr bool is_mem = std::is_same<Bus, Mem>::value;
+
+    /*  Zero page accesses, inlined into the handlers. They go straight to
+        the host pointer Mem has for page 0 and only call ReadByte or
+        WriteByte while it has none, e.g. with a device or a watched byte
+        on the page.
+    */
+    [[gnu::always_inline]] Byte ReadZeroPage(Byte addr);
+    [[gnu::always_inline]] void WriteZeroPage(Byte addr, Byte data);
+
+    /*  Reads an operand of size bytes at PC and moves PC past it. */
+    Word FetchOperand(Byte size);
+
+    /*  Executes one instruction through an inlined switch. Returns 0 for an
+        unknown opcode without reporting it, so batch loops can stop and
+        report it themselves.
+    */
+    u32 Step();
+
+    /*  The table holds plain function pointers rather than pointers to
+        members: calling through a member pointer costs an extra test for
+        virtual functions on every dispatch.
+    */
+    typedef u32 (*OpHandler)(BasicCPU&, Word);
+    typedef std::array<OpHandler, 0x100> DispatchTable;
+
+    static const DispatchTable s_dispatch;
+
 private:
 
-};
\ No newline at end of file
+    template <u32 (BasicCPU::*handler)(Word)>
+    static u32 Dispatch(BasicCPU& cpu, Word operand) { return (cpu.*handler)(operand); }
+
+    static constexpr DispatchTable BuildDispatchTable();
+};
+
+typedef BasicCPU<Nmos6502> CPU;
+typedef BasicCPU<Cmos65C02> CPU65C02;
+typedef BasicCPU<Ricoh2A03> CPU2A03;
+
+#include "cpu_ops.h"
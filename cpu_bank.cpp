@@ -0,0 +1,620 @@
+#include "cpu_bank.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CPU_BANK_AVX2 1
+#include <immintrin.h>
+// compiled for AVX2 and only called once HasSimd() says the host has it
+#define AVX2_FN __attribute__((target("avx2")))
+#endif
+
+static constexpr size_t vector_lanes = 32;
+// CpuBank::m_code_page for a lane whose code page has to be looked up again
+static constexpr Word no_code_page = 0x100;
+
+// status register bits, as in CPU::GetStatus
+static constexpr Byte FLAG_C = 0x01;
+static constexpr Byte FLAG_Z = 0x02;
+static constexpr Byte FLAG_I = 0x04;
+static constexpr Byte FLAG_D = 0x08;
+static constexpr Byte FLAG_V = 0x40;
+static constexpr Byte FLAG_N = 0x80;
+
+namespace {
+
+/*  What an opcode does on the SIMD path, which reads the addressing mode
+    from opcode_info.
+*/
+enum SimdKind : Byte {
+    SIMD_NONE,      // goes to the CPU
+    SIMD_LDA, SIMD_LDX, SIMD_LDY, SIMD_AND, SIMD_ADC, SIMD_BIT,
+    SIMD_STA, SIMD_STX, SIMD_STY,
+    SIMD_TAX, SIMD_TXA, SIMD_TAY, SIMD_TYA, SIMD_TSX, SIMD_TXS,
+    SIMD_SET,       // P |= flag
+    SIMD_CLEAR,     // P &= ~flag
+    SIMD_ASL, SIMD_LSR, SIMD_ROL, SIMD_ROR,
+    SIMD_BRANCH,    // taken when (P & flag) == value
+};
+
+struct SimdOp {
+    SimdKind kind;
+    Byte flag;
+    Byte value;
+};
+
+typedef std::array<SimdOp, 0x100> SimdTable;
+
+constexpr SimdTable BuildSimdTable() {
+    SimdTable table{};
+    for (Byte op : {INS_LDA_IM, INS_LDA_ZP, INS_LDA_ZPX, INS_LDA_ABS, INS_LDA_ABSX, INS_LDA_ABSY}) {
+        table[op] = SimdOp{ SIMD_LDA, 0, 0 };
+    }
+    for (Byte op : {INS_LDX_IM, INS_LDX_ZP, INS_LDX_ZPY, INS_LDX_ABS, INS_LDX_ABSY}) {
+        table[op] = SimdOp{ SIMD_LDX, 0, 0 };
+    }
+    for (Byte op : {INS_LDY_IM, INS_LDY_ZP, INS_LDY_ZPX, INS_LDY_ABS, INS_LDY_ABSX}) {
+        table[op] = SimdOp{ SIMD_LDY, 0, 0 };
+    }
+    for (Byte op : {INS_AND_IM, INS_AND_ZP, INS_AND_ZPX, INS_AND_ABS, INS_AND_ABSX, INS_AND_ABSY}) {
+        table[op] = SimdOp{ SIMD_AND, 0, 0 };
+    }
+    for (Byte op : {INS_ADC_IM, INS_ADC_ZP, INS_ADC_ZPX, INS_ADC_ABS, INS_ADC_ABSX, INS_ADC_ABSY}) {
+        table[op] = SimdOp{ SIMD_ADC, 0, 0 };
+    }
+    for (Byte op : {INS_BIT_ZP, INS_BIT_ABS}) {
+        table[op] = SimdOp{ SIMD_BIT, 0, 0 };
+    }
+    for (Byte op : {INS_STA_ZP, INS_STA_ZPX, INS_STA_ABS, INS_STA_ABSX, INS_STA_ABSY}) {
+        table[op] = SimdOp{ SIMD_STA, 0, 0 };
+    }
+    for (Byte op : {INS_STX_ZP, INS_STX_ZPY, INS_STX_ABS}) {
+        table[op] = SimdOp{ SIMD_STX, 0, 0 };
+    }
+    for (Byte op : {INS_STY_ZP, INS_STY_ZPX, INS_STY_ABS}) {
+        table[op] = SimdOp{ SIMD_STY, 0, 0 };
+    }
+    table[INS_TAX] = SimdOp{ SIMD_TAX, 0, 0 };
+    table[INS_TXA] = SimdOp{ SIMD_TXA, 0, 0 };
+    table[INS_TAY] = SimdOp{ SIMD_TAY, 0, 0 };
+    table[INS_TYA] = SimdOp{ SIMD_TYA, 0, 0 };
+    table[INS_TSX] = SimdOp{ SIMD_TSX, 0, 0 };
+    table[INS_TXS] = SimdOp{ SIMD_TXS, 0, 0 };
+    table[INS_SEC] = SimdOp{ SIMD_SET, FLAG_C, 0 };
+    table[INS_SED] = SimdOp{ SIMD_SET, FLAG_D, 0 };
+    table[INS_SEI] = SimdOp{ SIMD_SET, FLAG_I, 0 };
+    table[INS_CLC] = SimdOp{ SIMD_CLEAR, FLAG_C, 0 };
+    table[INS_CLD] = SimdOp{ SIMD_CLEAR, FLAG_D, 0 };
+    table[INS_CLI] = SimdOp{ SIMD_CLEAR, FLAG_I, 0 };
+    table[INS_ASL_A] = SimdOp{ SIMD_ASL, 0, 0 };
+    table[INS_LSR_A] = SimdOp{ SIMD_LSR, 0, 0 };
+    table[INS_ROL_A] = SimdOp{ SIMD_ROL, 0, 0 };
+    table[INS_ROR_A] = SimdOp{ SIMD_ROR, 0, 0 };
+    table[INS_BMI] = SimdOp{ SIMD_BRANCH, FLAG_N, FLAG_N };
+    table[INS_BPL] = SimdOp{ SIMD_BRANCH, FLAG_N, 0 };
+    table[INS_BEQ] = SimdOp{ SIMD_BRANCH, FLAG_Z, FLAG_Z };
+    table[INS_BNE] = SimdOp{ SIMD_BRANCH, FLAG_Z, 0 };
+    table[INS_BCS] = SimdOp{ SIMD_BRANCH, FLAG_C, FLAG_C };
+    table[INS_BCC] = SimdOp{ SIMD_BRANCH, FLAG_C, 0 };
+    table[INS_BVS] = SimdOp{ SIMD_BRANCH, FLAG_V, FLAG_V };
+    table[INS_BVC] = SimdOp{ SIMD_BRANCH, FLAG_V, 0 };
+    return table;
+}
+
+constexpr SimdTable simd_ops = BuildSimdTable();
+
+#ifdef CPU_BANK_AVX2
+
+/*  The register vectors of the bank. */
+struct LaneArrays {
+    Byte* A;
+    Byte* X;
+    Byte* Y;
+    Byte* SP;
+    Byte* P;
+    Word* PC;
+    u64* cycles;
+    Mem* const* mem;
+    Word* code_page;
+    size_t count;
+};
+
+AVX2_FN inline __m256i Load(const void* p) {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+AVX2_FN inline void Store(void* p, __m256i v) {
+    _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+}
+
+AVX2_FN inline __m256i Bytes(Byte b) {
+    return _mm256_set1_epi8(char(b));
+}
+
+/*  p with N and Z set from v. */
+AVX2_FN inline __m256i SetNZ(__m256i p, __m256i v) {
+    __m256i zero = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+    p = _mm256_and_si256(p, Bytes(Byte(~(FLAG_N | FLAG_Z))));
+    p = _mm256_or_si256(p, _mm256_and_si256(v, Bytes(FLAG_N)));
+    return _mm256_or_si256(p, _mm256_and_si256(zero, Bytes(FLAG_Z)));
+}
+
+/*  Sets group to 0xFF for each lane in todo at pc and returns how many. */
+AVX2_FN size_t GroupMask(const Word* PC, const Byte* todo, Word pc, Byte* group, size_t count) {
+    __m256i pcs = _mm256_set1_epi16(short(pc));
+    size_t size = 0;
+    for (size_t base = 0; base < count; base += vector_lanes) {
+        __m256i lo = _mm256_cmpeq_epi16(Load(PC + base), pcs);
+        __m256i hi = _mm256_cmpeq_epi16(Load(PC + base + 16), pcs);
+        // packs interleaves the two 128 bit halves, the permute undoes it
+        __m256i same = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xD8);
+        __m256i m = _mm256_and_si256(same, Load(todo + base));
+        Store(group + base, m);
+        size += __builtin_popcount(u32(_mm256_movemask_epi8(m)));
+    }
+    return size;
+}
+
+/*  32 bytes, 0xFF for each bit set in bits. */
+AVX2_FN inline __m256i ExpandBits(u32 bits) {
+    const __m256i bytes = _mm256_setr_epi64x(0, 0x0101010101010101, 0x0202020202020202, 0x0303030303030303);
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201);
+    __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(int(bits)), bytes);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(v, select), select);
+}
+
+/*  Keeps the lanes of group whose cached code page is page, as page_number,
+    and moves the rest to check for a closer look, along with any lane in
+    decimal mode when decimal is set. Returns whether check has any.
+*/
+AVX2_FN bool SplitGroup(Byte* group, Byte* check, const Byte* const* code, const Word* code_page, const Byte* P,
+    const Byte* page, Byte page_number, bool decimal, size_t count)
+{
+    __m256i pages = _mm256_set1_epi16(page_number);
+    __m256i pointer = _mm256_set1_epi64x((long long)page);
+    bool any = false;
+    for (size_t base = 0; base < count; base += vector_lanes) {
+        __m256i m = Load(group + base);
+        if (_mm256_testz_si256(m, m)) {
+            Store(check + base, m);
+            continue;
+        }
+        u32 same = 0;
+        for (size_t quarter = 0; quarter < vector_lanes; quarter += 4) {
+            __m256i eq = _mm256_cmpeq_epi64(Load(code + base + quarter), pointer);
+            same |= u32(_mm256_movemask_pd(_mm256_castsi256_pd(eq))) << quarter;
+        }
+        __m256i lo = _mm256_cmpeq_epi16(Load(code_page + base), pages);
+        __m256i hi = _mm256_cmpeq_epi16(Load(code_page + base + 16), pages);
+        __m256i fast = _mm256_and_si256(_mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xD8), ExpandBits(same));
+        if (decimal) {
+            __m256i d = _mm256_cmpeq_epi8(_mm256_and_si256(Load(P + base), Bytes(FLAG_D)), Bytes(FLAG_D));
+            fast = _mm256_andnot_si256(d, fast);
+        }
+        fast = _mm256_and_si256(fast, m);
+        __m256i slow = _mm256_andnot_si256(fast, m);
+        Store(group + base, fast);
+        Store(check + base, slow);
+        any |= !_mm256_testz_si256(slow, slow);
+    }
+    return any;
+}
+
+/*  Sets active to 0xFF for each lane that has not stopped and is short of
+    end, and returns whether there are any.
+*/
+AVX2_FN bool ActiveMask(const Byte* stopped, const u64* cycles, const u64* end, Byte* active, size_t count) {
+    // unsigned compares through the signed one
+    const __m256i sign = _mm256_set1_epi64x((long long)(u64(1) << 63));
+    bool any = false;
+    for (size_t base = 0; base < count; base += vector_lanes) {
+        u32 short_of_end = 0;
+        for (size_t quarter = 0; quarter < vector_lanes; quarter += 4) {
+            __m256i c = _mm256_xor_si256(Load(cycles + base + quarter), sign);
+            __m256i e = _mm256_xor_si256(Load(end + base + quarter), sign);
+            __m256i lt = _mm256_cmpgt_epi64(e, c);
+            short_of_end |= u32(_mm256_movemask_pd(_mm256_castsi256_pd(lt))) << quarter;
+        }
+        __m256i running = _mm256_cmpeq_epi8(Load(stopped + base), _mm256_setzero_si256());
+        __m256i m = _mm256_and_si256(running, ExpandBits(short_of_end));
+        Store(active + base, m);
+        any |= !_mm256_testz_si256(m, m);
+    }
+    return any;
+}
+
+/*  The memory access of a load or store for each lane in bits, a lane at a
+    time through its Mem. Loads put the byte read in value and any page
+    crossing cycle in extra.
+*/
+AVX2_FN void AccessMemory(const LaneArrays& l, size_t base, u32 bits, SimdKind kind, AddressingMode mode,
+    Word operand, Byte* value, Byte* extra)
+{
+    while (bits) {
+        u32 i = __builtin_ctz(bits);
+        bits &= bits - 1;
+        size_t lane = base + i;
+        Mem* mem = l.mem[lane];
+        Byte index = 0;
+        switch (mode) {
+            case AM_ZPX:
+            case AM_ABSX: index = l.X[lane]; break;
+            case AM_ZPY:
+            case AM_ABSY: index = l.Y[lane]; break;
+            default: break;
+        }
+        Word addr = operand + index;
+        // like CPU, zero page indexed loads wrap within page 0 and stores do not
+        bool store = kind == SIMD_STA || kind == SIMD_STX || kind == SIMD_STY;
+        if ((mode == AM_ZPX || mode == AM_ZPY) && !store) {
+            addr &= 0xFF;
+        }
+        // Through the page pointers where Mem has them, which leaves the
+        // lane's cached code page valid, as CPU does for the zero page.
+        if (store) {
+            Byte data = kind == SIMD_STA ? l.A[lane] : kind == SIMD_STX ? l.X[lane] : l.Y[lane];
+            Byte* page = mem->WritePage(addr >> 8);
+            if (page) {
+                page[addr & 0xFF] = data;
+            } else {
+                mem->WriteByte(addr, data);
+                l.code_page[lane] = no_code_page;
+            }
+        } else {
+            const Byte* page = mem->ReadPage(addr >> 8);
+            if (page) {
+                value[i] = page[addr & 0xFF];
+            } else {
+                value[i] = mem->ReadByte(addr);
+                l.code_page[lane] = no_code_page;
+            }
+            extra[i] = (mode == AM_ABSX || mode == AM_ABSY) && (((operand & 0xFF) + index) & 0x100);
+        }
+    }
+}
+
+/*  Runs one instruction on every lane in group, which all have the same
+    code at pc, and clears them in todo. Returns how many there were.
+*/
+AVX2_FN size_t ExecuteGroup(const LaneArrays& l, const Byte* group, Byte* todo, Byte opcode, Word pc, Word operand) {
+    const SimdOp op = simd_ops[opcode];
+    const OpcodeInfo& info = opcode_info[opcode];
+    const bool memory = info.mode != AM_IMP && info.mode != AM_ACC && info.mode != AM_IMM && info.mode != AM_REL;
+
+    Word next = pc + 1 + info.operand_size;
+    Word target = next;
+    Byte branch_cycles = 0;
+    if (op.kind == SIMD_BRANCH) {
+        Byte r = operand;
+        target = r & 0x80 ? next - (0x100 - r) : next + r;
+        branch_cycles = (target & 0x100) != (next & 0x100) ? 2 : 1;
+    }
+    const __m256i one = Bytes(1);
+    const __m256i next_pc = _mm256_set1_epi16(short(next));
+    const __m256i target_pc = _mm256_set1_epi16(short(target));
+
+    size_t size = 0;
+    for (size_t base = 0; base < l.count; base += vector_lanes) {
+        __m256i m = Load(group + base);
+        if (_mm256_testz_si256(m, m)) {
+            continue;
+        }
+        Store(todo + base, _mm256_andnot_si256(m, Load(todo + base)));
+        size += __builtin_popcount(u32(_mm256_movemask_epi8(m)));
+        __m256i a = Load(l.A + base);
+        __m256i x = Load(l.X + base);
+        __m256i y = Load(l.Y + base);
+        __m256i sp = Load(l.SP + base);
+        __m256i p = Load(l.P + base);
+
+        alignas(32) Byte value[vector_lanes];
+        alignas(32) Byte extra_bytes[vector_lanes] = {};
+        __m256i v = Bytes(Byte(operand));
+        if (memory) {
+            AccessMemory(l, base, u32(_mm256_movemask_epi8(m)), op.kind, info.mode, operand, value, extra_bytes);
+            v = Load(value);
+        }
+        __m256i extra = Load(extra_bytes);
+        __m256i taken = _mm256_setzero_si256();
+
+        switch (op.kind) {
+            case SIMD_LDA: a = v; p = SetNZ(p, a); break;
+            case SIMD_LDX: x = v; p = SetNZ(p, x); break;
+            case SIMD_LDY: y = v; p = SetNZ(p, y); break;
+            case SIMD_AND: a = _mm256_and_si256(a, v); p = SetNZ(p, a); break;
+            case SIMD_ADC: {
+                __m256i r = _mm256_add_epi8(_mm256_add_epi8(a, v), _mm256_and_si256(p, one));
+                // bit 7 of each: the carry out of bit 7, and V as adc_table
+                // has it, set only when two positive operands sum to a negative
+                __m256i carry = _mm256_or_si256(_mm256_and_si256(a, v), _mm256_andnot_si256(r, _mm256_or_si256(a, v)));
+                __m256i overflow = _mm256_andnot_si256(_mm256_or_si256(a, v), _mm256_add_epi8(a, v));
+                p = SetNZ(_mm256_and_si256(p, Bytes(Byte(~(FLAG_V | FLAG_C)))), r);
+                p = _mm256_or_si256(p, _mm256_and_si256(_mm256_srli_epi16(overflow, 1), Bytes(FLAG_V)));
+                p = _mm256_or_si256(p, _mm256_and_si256(_mm256_srli_epi16(carry, 7), one));
+                a = r;
+                break;
+            }
+            case SIMD_BIT: {
+                __m256i zero = _mm256_cmpeq_epi8(_mm256_and_si256(a, v), _mm256_setzero_si256());
+                p = _mm256_and_si256(p, Bytes(Byte(~(FLAG_N | FLAG_V | FLAG_Z))));
+                p = _mm256_or_si256(p, _mm256_and_si256(v, Bytes(FLAG_N | FLAG_V)));
+                p = _mm256_or_si256(p, _mm256_and_si256(zero, Bytes(FLAG_Z)));
+                break;
+            }
+            case SIMD_STA:
+            case SIMD_STX:
+            case SIMD_STY:
+                break;
+            case SIMD_TAX: x = a; p = SetNZ(p, x); break;
+            case SIMD_TXA: a = x; p = SetNZ(p, a); break;
+            case SIMD_TAY: y = a; p = SetNZ(p, y); break;
+            case SIMD_TYA: a = y; p = SetNZ(p, a); break;
+            case SIMD_TSX: x = sp; p = SetNZ(p, x); break;
+            case SIMD_TXS: sp = x; p = SetNZ(p, sp); break;
+            case SIMD_SET: p = _mm256_or_si256(p, Bytes(op.flag)); break;
+            case SIMD_CLEAR: p = _mm256_and_si256(p, Bytes(Byte(~op.flag))); break;
+            case SIMD_ASL:
+            case SIMD_LSR:
+            case SIMD_ROL:
+            case SIMD_ROR: {
+                // 16 bit shifts, masked so no bit crosses into the next lane
+                bool left = op.kind == SIMD_ASL || op.kind == SIMD_ROL;
+                __m256i carry = left ? _mm256_and_si256(_mm256_srli_epi16(a, 7), one) : _mm256_and_si256(a, one);
+                a = left ? _mm256_and_si256(_mm256_slli_epi16(a, 1), Bytes(0xFE))
+                         : _mm256_and_si256(_mm256_srli_epi16(a, 1), Bytes(0x7F));
+                if (op.kind == SIMD_ROL) {
+                    a = _mm256_or_si256(a, _mm256_and_si256(p, one));
+                } else if (op.kind == SIMD_ROR) {
+                    a = _mm256_or_si256(a, _mm256_slli_epi16(_mm256_and_si256(p, one), 7));
+                }
+                p = SetNZ(_mm256_and_si256(p, Bytes(Byte(~FLAG_C))), a);
+                p = _mm256_or_si256(p, carry);
+                break;
+            }
+            case SIMD_BRANCH:
+                taken = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(p, Bytes(op.flag)), Bytes(op.value)), m);
+                extra = _mm256_and_si256(taken, Bytes(branch_cycles));
+                break;
+            case SIMD_NONE:
+                break;
+        }
+
+        Store(l.A + base, _mm256_blendv_epi8(Load(l.A + base), a, m));
+        Store(l.X + base, _mm256_blendv_epi8(Load(l.X + base), x, m));
+        Store(l.Y + base, _mm256_blendv_epi8(Load(l.Y + base), y, m));
+        Store(l.SP + base, _mm256_blendv_epi8(Load(l.SP + base), sp, m));
+        Store(l.P + base, _mm256_blendv_epi8(Load(l.P + base), p, m));
+
+        for (size_t half = 0; half < 2; ++half) {
+            __m128i m8 = half ? _mm256_extracti128_si256(m, 1) : _mm256_castsi256_si128(m);
+            __m128i t8 = half ? _mm256_extracti128_si256(taken, 1) : _mm256_castsi256_si128(taken);
+            Word* pcs = l.PC + base + half * 16;
+            __m256i pc16 = _mm256_blendv_epi8(Load(pcs), next_pc, _mm256_cvtepi8_epi16(m8));
+            Store(pcs, _mm256_blendv_epi8(pc16, target_pc, _mm256_cvtepi8_epi16(t8)));
+        }
+
+        alignas(32) Byte used[vector_lanes];
+        Store(used, _mm256_and_si256(m, _mm256_add_epi8(Bytes(info.cycles), extra)));
+        for (size_t quarter = 0; quarter < vector_lanes; quarter += 4) {
+            int four;
+            memcpy(&four, used + quarter, sizeof(four));
+            u64* c = l.cycles + base + quarter;
+            Store(c, _mm256_add_epi64(Load(c), _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(four))));
+        }
+    }
+    return size;
+}
+
+#endif
+
+}
+
+CpuBank::CpuBank(size_t lanes) :
+    min_group(4),
+    simd(HasSimd()),
+    simd_steps(0),
+    scalar_steps(0),
+    m_lanes(lanes),
+    m_cpu(nullptr)
+{
+    size_t padded = (lanes + vector_lanes - 1) / vector_lanes * vector_lanes;
+    mem.resize(padded, nullptr);
+    A.resize(padded);
+    X.resize(padded);
+    Y.resize(padded);
+    SP.resize(padded);
+    P.resize(padded);
+    PC.resize(padded);
+    cycles.resize(padded);
+    stopped.resize(padded, 1);
+    m_group.resize(padded);
+    m_active.resize(padded);
+    m_end.resize(padded);
+    m_check.resize(padded);
+    m_code.resize(padded);
+    m_code_page.resize(padded, no_code_page);
+}
+
+bool CpuBank::HasSimd() {
+#ifdef CPU_BANK_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+void CpuBank::Load(size_t lane, const CPU& cpu) {
+    mem[lane] = cpu.mem;
+    A[lane] = cpu.A;
+    X[lane] = cpu.X;
+    Y[lane] = cpu.Y;
+    SP[lane] = cpu.SP;
+    P[lane] = cpu.GetStatus();
+    PC[lane] = cpu.PC;
+    cycles[lane] = 0;
+    stopped[lane] = 0;
+    m_code_page[lane] = no_code_page;
+}
+
+void CpuBank::Store(size_t lane, CPU& cpu) const {
+    cpu.mem = mem[lane];
+    cpu.A = A[lane];
+    cpu.X = X[lane];
+    cpu.Y = Y[lane];
+    cpu.SP = SP[lane];
+    cpu.SetStatus(P[lane]);
+    cpu.PC = PC[lane];
+}
+
+size_t CpuBank::Step() {
+    // the Mems may have changed since the last call
+    std::fill(m_code_page.begin(), m_code_page.end(), no_code_page);
+    for (size_t lane = 0; lane < m_lanes; ++lane) {
+        m_active[lane] = stopped[lane] ? 0 : 0xFF;
+    }
+    StepLanes(m_active.data());
+    size_t running = 0;
+    for (size_t lane = 0; lane < m_lanes; ++lane) {
+        running += !stopped[lane];
+    }
+    return running;
+}
+
+void CpuBank::Run(u64 cycle_budget) {
+    std::fill(m_code_page.begin(), m_code_page.end(), no_code_page);
+    for (size_t lane = 0; lane < m_lanes; ++lane) {
+        m_end[lane] = cycles[lane] + std::min(cycle_budget, ~u64(0) - cycles[lane]);
+    }
+    for (;;) {
+        bool any = false;
+#ifdef CPU_BANK_AVX2
+        if (simd && HasSimd()) {
+            any = ActiveMask(stopped.data(), cycles.data(), m_end.data(), m_active.data(), m_active.size());
+        } else
+#endif
+        for (size_t lane = 0; lane < m_lanes; ++lane) {
+            bool active = !stopped[lane] && cycles[lane] < m_end[lane];
+            m_active[lane] = active ? 0xFF : 0;
+            any |= active;
+        }
+        if (!any) {
+            break;
+        }
+        StepLanes(m_active.data());
+    }
+}
+
+void CpuBank::StepLanes(Byte* todo) {
+    // every lane before the current one has been run and cleared in todo
+    for (size_t lane = 0; lane < m_lanes; ++lane) {
+        u64 eight = 0;
+        if ((lane & 7) == 0) {
+            // the vectors are padded to 32 lanes, so there are 8 more
+            memcpy(&eight, todo + lane, sizeof(eight));
+            if (eight == 0) {
+                lane += 7;
+                continue;
+            }
+        }
+        if (todo[lane] && !StepGroup(lane, todo)) {
+            StepScalar(lane);
+            todo[lane] = 0;
+        }
+    }
+}
+
+bool CpuBank::StepGroup(size_t leader, Byte* todo) {
+#ifdef CPU_BANK_AVX2
+    if (!simd || !HasSimd()) {
+        return false;
+    }
+    Word pc = PC[leader];
+    const Byte* page = CodePage(leader, pc >> 8);
+    if (!page) {
+        return false;
+    }
+    Byte offset = pc & 0xFF;
+    Byte opcode = page[offset];
+    size_t length = opcode_info[opcode].operand_size + 1;
+    if (simd_ops[opcode].kind == SIMD_NONE || offset + length > Mem::page_size) {
+        return false;
+    }
+    size_t count = GroupMask(PC.data(), todo, pc, m_group.data(), m_group.size());
+    if (count < min_group) {
+        return false;
+    }
+
+    // Lanes whose code differs stay in todo and lead a group of their own
+    // later. Decimal mode ADC goes to the CPU.
+    bool adc = simd_ops[opcode].kind == SIMD_ADC;
+    if (SplitGroup(m_group.data(), m_check.data(), m_code.data(), m_code_page.data(), P.data(),
+        page, pc >> 8, adc, m_group.size()))
+    {
+        for (size_t lane = leader; lane < m_lanes; ++lane) {
+            if (!m_check[lane]) {
+                continue;
+            }
+            const Byte* code = CodePage(lane, pc >> 8);
+            if (code != page && (!code || memcmp(code + offset, page + offset, length) != 0)) {
+                continue;
+            }
+            if (adc && (P[lane] & FLAG_D)) {
+                StepScalar(lane);
+                todo[lane] = 0;
+            } else {
+                m_group[lane] = 0xFF;
+            }
+        }
+    }
+
+    Word operand = 0;
+    if (length == 2) {
+        operand = page[offset + 1];
+    } else if (length == 3) {
+        operand = page[offset + 1] | (Word(page[offset + 2]) << 8);
+    }
+    LaneArrays lanes = { A.data(), X.data(), Y.data(), SP.data(), P.data(), PC.data(), cycles.data(), mem.data(),
+        m_code_page.data(), m_group.size() };
+    simd_steps += ExecuteGroup(lanes, m_group.data(), todo, opcode, pc, operand);
+    return true;
+#else
+    (void)leader;
+    (void)todo;
+    return false;
+#endif
+}
+
+const Byte* CpuBank::CodePage(size_t lane, Byte page) {
+    if (m_code_page[lane] != page) {
+        m_code[lane] = mem[lane]->ReadPage(page);
+        m_code_page[lane] = page;
+    }
+    return m_code[lane];
+}
+
+void CpuBank::StepScalar(size_t lane) {
+    m_code_page[lane] = no_code_page;
+    m_cpu.mem = mem[lane];
+    m_cpu.A = A[lane];
+    m_cpu.X = X[lane];
+    m_cpu.Y = Y[lane];
+    m_cpu.SP = SP[lane];
+    m_cpu.SetStatus(P[lane]);
+    m_cpu.PC = PC[lane];
+
+    u32 used = m_cpu.RunOneInstruction();
+
+    A[lane] = m_cpu.A;
+    X[lane] = m_cpu.X;
+    Y[lane] = m_cpu.Y;
+    SP[lane] = m_cpu.SP;
+    P[lane] = m_cpu.GetStatus();
+    PC[lane] = m_cpu.PC;
+    if (used == 0) {
+        stopped[lane] = 1;
+    } else {
+        cycles[lane] += used;
+    }
+    ++scalar_steps;
+}
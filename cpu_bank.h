@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include "types.h"
+#include "cpu.h"
+#include "mem.h"
+
+/*  The registers of many CPUs in structure-of-arrays form, one lane per
+    CPU, for running many instances of the same program side by side, e.g.
+    one ROM on different inputs.
+
+    Step runs one instruction on every lane, with the same result on each
+    lane as CPU::RunOneInstruction. Lanes at the same PC with the same code
+    bytes there form a group, and when the opcode is one the SIMD path
+    knows, the group executes it together, 32 lanes to an AVX2 register.
+    Everything else is split off to the scalar CPU: the lane is loaded into
+    a CPU, stepped with RunOneInstruction and stored back. So are groups of
+    fewer than min_group lanes.
+
+    The SIMD path covers the loads, stores, AND, ADC and BIT with
+    immediate, zero page and absolute operands (indexed or not), the
+    accumulator shifts, the transfers, the flag instructions and the
+    branches. Memory operands are still read and written a lane at a time
+    through the lane's Mem. ADC in decimal mode, the indirect modes and the
+    shifts and rotates of memory go to the CPU, as does everything on hosts
+    without AVX2.
+
+    Every lane needs its own Mem. The register vectors are padded to a
+    multiple of 32 lanes; the padding lanes are always stopped.
+*/
+class CpuBank {
+public:
+
+    explicit CpuBank(size_t lanes);
+
+    size_t Lanes() const { return m_lanes; }
+
+    /*  Copies cpu's registers, flags and Mem into lane and starts it. */
+    void Load(size_t lane, const CPU& cpu);
+
+    /*  Copies lane back into cpu. */
+    void Store(size_t lane, CPU& cpu) const;
+
+    /*  Runs one instruction on every lane that has not stopped and returns
+        how many have not. A lane stops on an unknown opcode, which the CPU
+        reports as usual.
+    */
+    size_t Step();
+
+    /*  Steps every lane until it has run at least cycle_budget more cycles
+        or stopped, as CPU::Run would on each.
+    */
+    void Run(u64 cycle_budget);
+
+    /*  Whether this host can run the SIMD path. */
+    static bool HasSimd();
+
+    std::vector<Mem*> mem;
+    std::vector<Byte> A, X, Y, SP;
+    std::vector<Byte> P;            // the flags, as CPU::GetStatus returns them
+    std::vector<Word> PC;
+    std::vector<u64> cycles;        // cycles each lane has run
+    std::vector<Byte> stopped;      // non-zero until Load, and once a lane hits an unknown opcode
+
+    size_t min_group;               // smallest group run on the SIMD path
+    bool simd;                      // false runs every lane through the CPU
+
+    u64 simd_steps;                 // instructions run on the SIMD path
+    u64 scalar_steps;               // instructions run by the CPU
+
+private:
+
+    /*  Runs one instruction on every lane whose todo byte is set. */
+    void StepLanes(Byte* todo);
+
+    /*  Runs the group of lanes in todo that share leader's PC and code on
+        the SIMD path and clears them in todo. False, touching nothing, when
+        the group has to go to the CPU.
+    */
+    bool StepGroup(size_t leader, Byte* todo);
+
+    void StepScalar(size_t lane);
+
+    /*  Mem::ReadPage(page) for lane, remembered until the lane next
+        accesses memory or the next Step or Run.
+    */
+    const Byte* CodePage(size_t lane, Byte page);
+
+    size_t m_lanes;
+    CPU m_cpu;
+    std::vector<Byte> m_group;      // lanes of the group being run
+    std::vector<Byte> m_check;      // lanes that might join it
+    std::vector<Byte> m_active;
+    std::vector<u64> m_end;
+    std::vector<const Byte*> m_code;
+    std::vector<Word> m_code_page;  // the page m_code is for
+};
@@ -0,0 +1,1202 @@
+#pragma once
+/*  Definitions for cpu.h: the instruction handlers, the batch run loop
+    and the rest of BasicCPU.
+
+    The handlers are defined here instead of in cpu.cpp so that an engine
+    that calls them directly (see threaded_cpu.cpp, CPU::RunUntil) gets
+    their bodies inlined into its own dispatch loop, and so that BasicCPU
+    can be instantiated on any bus. cpu.cpp instantiates the variants on
+    Mem once. cpu.h includes this file at the end; the helper macros are
+    undefined again below.
+*/
+#include "cpu.h"
+#include "mem.h"
+#include "decode_cache.h"
+#include "adc_table.h"
+
+#define SET_BIT_FLAGS(v) do {                       \
+        m_zero = A & v;                             \
+        m_overflow = v & 0x40;                      \
+        m_negative = v;                             \
+    } while(false)
+
+#define SET_LOAD_REG_FLAGS(v) do {  \
+    m_zero = v;                     \
+    m_negative = v;                 \
+    } while(false)
+
+#define SET_LSR_FLAGS(v) SET_LOAD_REG_FLAGS(v)
+#define SET_ROR_FLAGS(v) SET_LOAD_REG_FLAGS(v)
+#define SET_ROL_FLAGS(v) SET_LOAD_REG_FLAGS(v)
+#define SET_ASL_FLAGS(v) SET_LOAD_REG_FLAGS(v)
+
+/*  A = A + v + C through adc_table, with all four flags. Variants without
+    decimal mode never look at the flag.
+*/
+#define DO_ADC(v) do {                                                  \
+    Byte decimal = Variant::has_decimal ? DecimalMode : 0;              \
+    AdcResult r = adc_table[AdcIndex(A, v, GetCarry(), decimal)];       \
+    A = r.result;                                                       \
+    m_zero = A;                                                         \
+    m_negative = A;                                                     \
+    m_carry = Word(r.flags & ADC_FLAG_C) << 8;                          \
+    m_overflow = r.flags & ADC_FLAG_V;                                  \
+    } while(false)
+
+/*  Cycles ADC takes on top of its base cycles and any page crossing. */
+#define ADC_EXTRA_CYCLES (Variant::decimal_extra_cycle && DecimalMode)
+
+/*  Cycles a $nnnn,X shift or rotate takes on top of its base cycles: the
+    65C02 only spends its 7th cycle on a page crossing.
+*/
+#define RMW_ABSX_EXTRA_CYCLES(addr) \
+    (Variant::rmw_absx_page_penalty && (((addr & 0xFF) + X) & 0x100) == 0x100)
+
+#define DO_LSR(x) do {          \
+        Byte newC = x & 0x01;   \
+        x = (x >> 1);           \
+        SetCarry(newC);         \
+    }while(false)
+
+#define DO_ROR(x) do {          \
+        Byte newC = x & 0x01;   \
+        x = (x >> 1);           \
+        if (GetCarry()) {       \
+            x += 0x80;          \
+        }                       \
+        SetCarry(newC);         \
+    }while(false)
+
+#define DO_ROL(x) do {                      \
+        Byte newC = (x & 0x80) == 0x80;     \
+        x = (x << 1);                       \
+        if (GetCarry()) {                   \
+            x += 0x01;                      \
+        }                                   \
+        SetCarry(newC);                     \
+    }while(false)
+
+#define DO_ASL(x) do {                      \
+        Byte newC = (x & 0x80) == 0x80;     \
+        x = (x << 1);                       \
+        SetCarry(newC);                     \
+    }while(false)
+
+#define DO_RELATIVE_JUMP(r) do {    \
+        if (r & 0x80) {             \
+            PC -= (0x100 - r);      \
+        } else {                    \
+            PC += r;                \
+        }                           \
+    }while(false)
+
+template <typename Variant, typename Bus>
+inline Byte BasicCPU<Variant, Bus>::ReadZeroPage(Byte addr) {
+    if constexpr (is_mem) {
+        const Byte* page = mem->ReadPage(0);
+        return page ? page[addr] : mem->ReadByte(addr);
+    } else {
+        return mem->ReadByte(addr);
+    }
+}
+
+template <typename Variant, typename Bus>
+inline void BasicCPU<Variant, Bus>::WriteZeroPage(Byte addr, Byte data) {
+    if constexpr (is_mem) {
+        Byte* page = mem->WritePage(0);
+        if (page) {
+            page[addr] = data;
+            return;
+        }
+    }
+    mem->WriteByte(addr, data);
+}
+
+/*  Prints the opcode BasicCPU did not know, defined in cpu.cpp. */
+void ReportUnknownOpcode(Byte opcode);
+
+#define OPCODE(name) template <typename Variant, typename Bus> inline u32 BasicCPU<Variant, Bus>::Op_##name(Word operand)
+
+OPCODE(LDA_IM) {
+    A = operand;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LDA_ZP) {
+    Word addr = 0x0000 + operand;
+    A = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LDA_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    A = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LDA_ABS) {
+    Word addr = operand;
+    A = mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LDA_ABSX) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + X);
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + X ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(LDA_ABSY) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + Y);
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(LDA_INDX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    addr = mem->ReadWord(addr);
+    A = mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LDA_INDY) {
+    // get zeropage addr
+    Byte offset = operand;
+    // get the abs addr at zp
+    Byte lsb = ReadZeroPage(offset);
+    Byte msb = ReadZeroPage(offset + 1);
+    Word addr = (Word(msb) << 8) + lsb;
+
+    // add y to abs addr
+    // set a to value located at final addr
+    A = mem->ReadByte(addr + Y);
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(LDX_IM) {
+    X = operand;
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(LDX_ZP) {
+    Word addr = 0x0000 + operand;
+    X = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(LDX_ZPY) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (Y + offset) & 0xFF;
+    X = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(LDX_ABS) {
+    Word addr = operand;
+    X = mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(LDX_ABSY) {
+    Word addr = operand;
+    X = mem->ReadByte(addr + Y);
+
+    SET_LOAD_REG_FLAGS(X);
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(LDY_IM) {
+    Y = operand;
+    SET_LOAD_REG_FLAGS(Y);
+    return 0;
+}
+
+OPCODE(LDY_ZP) {
+    Word addr = 0x0000 + operand;
+    Y = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(Y);
+    return 0;
+}
+
+OPCODE(LDY_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    Y = ReadZeroPage(addr);
+
+    SET_LOAD_REG_FLAGS(Y);
+    return 0;
+}
+
+OPCODE(LDY_ABS) {
+    Word addr = operand;
+    Y = mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(Y);
+    return 0;
+}
+
+OPCODE(LDY_ABSX) {
+    Word addr = operand;
+    Y = mem->ReadByte(addr + X);
+
+    SET_LOAD_REG_FLAGS(Y);
+    if ((((addr & 0xFF) + X ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(LSR_A) {
+    DO_LSR(A);
+    
+    SET_LSR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LSR_ZP) {
+    Word addr = 0x0000 + operand;
+    A = ReadZeroPage(addr);
+    DO_LSR(A);
+    WriteZeroPage(addr, A);
+    SET_LSR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LSR_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    A = ReadZeroPage(addr);
+
+    DO_LSR(A);
+    WriteZeroPage(addr, A);
+    SET_LSR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LSR_ABS) {
+    Word addr = operand;
+    A = mem->ReadByte(addr);
+
+    DO_LSR(A);
+    mem->WriteByte(addr, A);
+    SET_LSR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(LSR_ABSX) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + X);
+
+    DO_LSR(A);
+    mem->WriteByte(addr + X, A);
+    SET_LSR_FLAGS(A);
+    return RMW_ABSX_EXTRA_CYCLES(addr);
+}
+
+OPCODE(ROR_A) {
+    DO_ROR(A);
+    
+    SET_ROR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROR_ABS) {
+    Word addr = operand;
+    A = mem->ReadByte(addr);
+
+    DO_ROR(A);
+    mem->WriteByte(addr, A);
+    SET_ROR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROR_ABSX) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + X);
+
+    DO_ROR(A);
+    mem->WriteByte(addr + X, A);
+    SET_ROR_FLAGS(A);
+    return RMW_ABSX_EXTRA_CYCLES(addr);
+}
+
+OPCODE(ROR_ZP) {
+    Word addr = 0x0000 + operand;
+    A = ReadZeroPage(addr);
+    DO_ROR(A);
+    WriteZeroPage(addr, A);
+    SET_ROR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROR_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    A = ReadZeroPage(addr);
+
+    DO_ROR(A);
+    WriteZeroPage(addr, A);
+    SET_ROR_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROL_A) {
+    DO_ROL(A);
+    
+    SET_ROL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROL_ABS) {
+    Word addr = operand;
+    A = mem->ReadByte(addr);
+
+    DO_ROL(A);
+    mem->WriteByte(addr, A);
+    SET_ROL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROL_ABSX) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + X);
+
+    DO_ROL(A);
+    mem->WriteByte(addr + X, A);
+    SET_ROL_FLAGS(A);
+    return RMW_ABSX_EXTRA_CYCLES(addr);
+}
+
+OPCODE(ROL_ZP) {
+    Word addr = 0x0000 + operand;
+    A = ReadZeroPage(addr);
+    DO_ROL(A);
+    WriteZeroPage(addr, A);
+    SET_ROL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ROL_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    A = ReadZeroPage(addr);
+
+    DO_ROL(A);
+    WriteZeroPage(addr, A);
+    SET_ROL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ASL_A) {
+    DO_ASL(A);
+    
+    SET_ASL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ASL_ABS) {
+    Word addr = operand;
+    A = mem->ReadByte(addr);
+
+    DO_ASL(A);
+    mem->WriteByte(addr, A);
+    SET_ASL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ASL_ABSX) {
+    Word addr = operand;
+    A = mem->ReadByte(addr + X);
+
+    DO_ASL(A);
+    mem->WriteByte(addr + X, A);
+    SET_ASL_FLAGS(A);
+    return RMW_ABSX_EXTRA_CYCLES(addr);
+}
+
+OPCODE(ASL_ZP) {
+    Word addr = 0x0000 + operand;
+    A = ReadZeroPage(addr);
+    DO_ASL(A);
+    WriteZeroPage(addr, A);
+    SET_ASL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ASL_ZPX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    A = ReadZeroPage(addr);
+
+    DO_ASL(A);
+    WriteZeroPage(addr, A);
+    SET_ASL_FLAGS(A);
+    return 0;
+}
+
+OPCODE(STA_ZP) {
+    Word addr = 0x0000 + operand;
+    WriteZeroPage(addr, A);
+    return 0;
+}
+
+OPCODE(STA_ZPX) {
+    Word addr = 0x0000 + operand + X;
+    mem->WriteByte(addr, A);
+    return 0;
+}
+
+OPCODE(STA_ABS) {
+    Word addr = operand;
+    mem->WriteByte(addr, A);
+    return 0;
+}
+
+OPCODE(STA_ABSX) {
+    Word addr = operand + X;
+    mem->WriteByte(addr, A);
+    return 0;
+}
+
+OPCODE(STA_ABSY) {
+    Word addr = operand + Y;
+    mem->WriteByte(addr, A);
+    return 0;
+}
+
+OPCODE(STA_INDX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    addr = mem->ReadWord(addr);
+    mem->WriteByte(addr, A);
+
+    return 0;
+}
+
+OPCODE(STA_INDY) {
+    // get zeropage addr
+    Byte offset = operand;
+    // get the abs addr at zp
+    Byte lsb = ReadZeroPage(offset);
+    Byte msb = ReadZeroPage(offset + 1);
+    Word addr = (Word(msb) << 8) + lsb;
+
+    // add y to abs addr
+    // set a to value located at final addr
+    mem->WriteByte(addr + Y, A);
+
+    return 0;
+}
+
+OPCODE(STX_ZP) {
+    Word addr = 0x0000 + operand;
+    WriteZeroPage(addr, X);
+    return 0;
+}
+
+OPCODE(STX_ZPY) {
+    Word addr = 0x0000 + operand + Y;
+    mem->WriteByte(addr, X);
+    return 0;
+}
+
+OPCODE(STX_ABS) {
+    Word addr = operand;
+    mem->WriteByte(addr, X);
+    return 0;
+}
+
+OPCODE(STY_ZP) {
+    Word addr = 0x0000 + operand;
+    WriteZeroPage(addr, Y);
+    return 0;
+}
+
+OPCODE(STY_ZPX) {
+    Word addr = 0x0000 + operand + X;
+    mem->WriteByte(addr, Y);
+    return 0;
+}
+
+OPCODE(STY_ABS) {
+    Word addr = operand;
+    mem->WriteByte(addr, Y);
+    return 0;
+}
+
+OPCODE(TAX) {
+    X = A;
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(TXA) {
+    A = X;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(TAY) {
+    Y = A;
+    SET_LOAD_REG_FLAGS(Y);
+    return 0;
+}
+
+OPCODE(TYA) {
+    A = Y;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(TSX) {
+    X = SP;
+    SET_LOAD_REG_FLAGS(X);
+    return 0;
+}
+
+OPCODE(TXS) {
+    SP = X;
+    SET_LOAD_REG_FLAGS(SP);
+    return 0;
+}
+
+OPCODE(SEC) {
+    SetCarry(1);
+    return 0;
+}
+
+OPCODE(SED) {
+    DecimalMode = 1;
+    return 0;
+}
+
+OPCODE(SEI) {
+    InterruptDisable = 1;
+    return 0;
+}
+
+OPCODE(CLC) {
+    SetCarry(0);
+    return 0;
+}
+
+OPCODE(CLD) {
+    DecimalMode = 0;
+    return 0;
+}
+
+OPCODE(CLI) {
+    InterruptDisable = 0;
+    return 0;
+}
+
+OPCODE(BIT_ZP) {
+    Word addr = 0x0000 + operand;
+    Byte v = ReadZeroPage(addr);
+
+    SET_BIT_FLAGS(v);
+
+    return 0;
+}
+
+OPCODE(BIT_ABS) {
+    Word addr = operand;
+    Byte v = mem->ReadByte(addr);
+
+    SET_BIT_FLAGS(v);
+
+    return 0;
+}
+
+OPCODE(BMI) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (GetNegative()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BNE) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (!GetZero()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BPL) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (!GetNegative()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BEQ) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (GetZero()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BCS) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (GetCarry()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BCC) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (!GetCarry()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BVC) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (!GetOverflow()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(BVS) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    if (GetOverflow()) {
+        DO_RELATIVE_JUMP(relative_jump);
+
+        auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+        if (page_crossed) {
+            return 2;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(AND_IM) {
+    Byte val = operand;
+    A &=  val;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(AND_ABS) {
+    Word addr = operand;
+    Byte val = mem->ReadByte(addr);
+    A &=  val;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(AND_ABSX) {
+    Word addr = operand;
+    Byte val = mem->ReadByte(addr + X);
+    A &= val;
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + X ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(AND_ABSY) {
+    Word addr = operand;
+    Byte val = mem->ReadByte(addr + Y);
+    A &= val;
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(AND_ZP) {
+    Word addr = 0x0000 + operand;
+    Byte val = ReadZeroPage(addr);
+    A &=  val;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(AND_ZPX) {
+    Word addr = 0x0000 + (operand + X) & 0xFF;
+    Byte val = ReadZeroPage(addr);
+    A &=  val;
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(AND_INDX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    addr = mem->ReadWord(addr);
+    Byte val = mem->ReadByte(addr);
+    A &= val;
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(AND_INDY) {
+    // get zeropage addr
+    Byte offset = operand;
+    // get the abs addr at zp
+    Byte lsb = ReadZeroPage(offset);
+    Byte msb = ReadZeroPage(offset + 1);
+    Word addr = (Word(msb) << 8) + lsb;
+
+    // add y to abs addr
+    // set a to value located at final addr
+    Byte val = mem->ReadByte(addr + Y);
+    A &= val;
+
+    SET_LOAD_REG_FLAGS(A);
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1;
+    }
+    return 0;
+}
+
+OPCODE(ADC_IM) {
+    Byte v = operand;
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_ABS) {
+    Word addr = operand;
+    Byte v = mem->ReadByte(addr);
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_ABSX) {
+    Word addr = operand;
+    Byte v = mem->ReadByte(addr + X);
+
+    DO_ADC(v);
+
+    if ((((addr & 0xFF) + X ) & 0x100) == 0x100) {
+        return 1 + ADC_EXTRA_CYCLES;
+    }
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_ABSY) {
+    Word addr = operand;
+    Byte v = mem->ReadByte(addr + Y);
+
+    DO_ADC(v);
+
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1 + ADC_EXTRA_CYCLES;
+    }
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_ZP) {
+    Word addr = 0x0000 + operand;
+    Byte v = ReadZeroPage(addr);
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_ZPX) {
+    Word addr = 0x0000 + (operand + X) & 0xFF;
+    Byte v = ReadZeroPage(addr);
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_INDX) {
+    Byte offset = operand;
+    Word addr = 0x0000 + (X + offset) & 0xFF;
+    addr = mem->ReadWord(addr);
+    Byte v = mem->ReadByte(addr);
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+OPCODE(ADC_INDY) {
+    // get zeropage addr
+    Byte offset = operand;
+    // get the abs addr at zp
+    Byte lsb = ReadZeroPage(offset);
+    Byte msb = ReadZeroPage(offset + 1);
+    Word addr = (Word(msb) << 8) + lsb;
+
+    // add y to abs addr
+    // set a to value located at final addr
+    Byte v = mem->ReadByte(addr + Y);
+
+    DO_ADC(v);
+
+    if ((((addr & 0xFF) + Y ) & 0x100) == 0x100) {
+        return 1 + ADC_EXTRA_CYCLES;
+    }
+    return ADC_EXTRA_CYCLES;
+}
+
+/*  65C02 only, see CPU_OPCODES_65C02. */
+
+OPCODE(BRA) {
+    Byte relative_jump = operand;
+    Word old_pc(PC);
+
+    DO_RELATIVE_JUMP(relative_jump);
+
+    auto page_crossed = (PC & 0x100) != (old_pc & 0x100);
+    if (page_crossed) {
+        return 2;
+    }
+    return 1;
+}
+
+/*  The address stored at zero page operand, wrapping within the zero page. */
+#define ZPI_ADDRESS(offset) \
+    ((Word(ReadZeroPage(offset + 1)) << 8) + ReadZeroPage(offset))
+
+OPCODE(LDA_ZPI) {
+    Word addr = ZPI_ADDRESS(operand);
+    A = mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(STA_ZPI) {
+    Word addr = ZPI_ADDRESS(operand);
+    mem->WriteByte(addr, A);
+
+    return 0;
+}
+
+OPCODE(AND_ZPI) {
+    Word addr = ZPI_ADDRESS(operand);
+    A &= mem->ReadByte(addr);
+
+    SET_LOAD_REG_FLAGS(A);
+    return 0;
+}
+
+OPCODE(ADC_ZPI) {
+    Word addr = ZPI_ADDRESS(operand);
+    Byte v = mem->ReadByte(addr);
+
+    DO_ADC(v);
+
+    return ADC_EXTRA_CYCLES;
+}
+
+template <typename Variant, typename Bus>
+inline DecodedInstruction BasicCPU<Variant, Bus>::Decode() {
+    DecodedInstruction d = is_mem && decode_cache && !Variant::cmos_opcodes
+        ? decode_cache->Fetch(PC)
+        : DecodeInstruction(*mem, PC, Opcodes());
+    PC += d.length;
+    return d;
+}
+
+template <typename Variant, typename Bus>
+inline Word BasicCPU<Variant, Bus>::FetchOperand(Byte size) {
+    Word operand = 0;
+    if (size == 1) {
+        operand = mem->ReadByte(PC);
+    } else if (size == 2) {
+        operand = mem->ReadWord(PC);
+    }
+    PC += size;
+    return operand;
+}
+
+template <typename Variant, typename Bus>
+inline u32 BasicCPU<Variant, Bus>::Step() {
+    DecodedInstruction d = Decode();
+    switch (d.opcode) {
+#define CPU_SWITCH_CASE(name, ...) \
+        case INS_##name: return Opcodes()[INS_##name].cycles + Op_##name(d.operand);
+#define CPU_SWITCH_CASE_65C02(name, ...) \
+        case INS_##name: if (!Variant::cmos_opcodes) break; return Opcodes()[INS_##name].cycles + Op_##name(d.operand);
+        CPU_OPCODES(CPU_SWITCH_CASE)
+        CPU_OPCODES_65C02(CPU_SWITCH_CASE_65C02)
+#undef CPU_SWITCH_CASE
+#undef CPU_SWITCH_CASE_65C02
+    }
+    return 0;
+}
+
+template <typename Variant, typename Bus>
+template <typename Stop>
+u64 BasicCPU<Variant, Bus>::RunUntil(Stop stop, u64 cycle_budget) {
+    // Run on a copy whose address never escapes, so the compiler can keep
+    // the registers and flags in host registers for the whole batch.
+    BasicCPU cpu(*this);
+    u64 cycles = 0;
+    u32 c = 1;
+    while (cycles < cycle_budget && !stop(static_cast<const BasicCPU&>(cpu))) {
+        c = cpu.Step();
+        if (c == 0) {
+            break;
+        }
+        cycles += c;
+    }
+    *this = cpu;
+
+    if (c == 0) {
+        Op_Unknown(0);
+    }
+    return cycles;
+}
+
+template <typename Variant, typename Bus>
+inline u64 BasicCPU<Variant, Bus>::RunUntil(Word stop_pc, u64 cycle_budget) {
+    return RunUntil([stop_pc](const BasicCPU& cpu) { return cpu.PC == stop_pc; }, cycle_budget);
+}
+
+template <typename Variant, typename Bus>
+inline u64 BasicCPU<Variant, Bus>::Run(u64 cycle_budget) {
+    return RunUntil([](const BasicCPU&) { return false; }, cycle_budget);
+}
+
+template <typename Variant, typename Bus>
+BasicCPU<Variant, Bus>::BasicCPU(Bus* m) :
+    A(0),
+    X(0),
+    Y(0),
+    SP(0xFD),
+    PC(0x00),
+    InterruptDisable(1),
+    DecimalMode(0),
+    BreakCommand(0),
+    decode_cache(nullptr),
+    m_carry(0),
+    m_zero(1),
+    m_negative(0),
+    m_overflow(0)
+{
+    
+    /*
+    Power On State:
+    A, X, Y = 0
+    SP = $FD
+    $4017 = $00 (frame irq enabled)
+    $4015 = $00 (all channels disabled)
+    $4000-$400F = $00
+    $4010-$4013 = $00
+    All 15 bits of noise channel LFSR = $0000
+
+    Status Flag values:
+    0011 0100
+    NVss DIZC
+    |||| ||||
+    |||| |||+- Carry
+    |||| ||+-- Zero
+    |||| |+--- Interrupt Disable
+    |||| +---- Decimal
+    ||++------ No CPU effect, see: the B flag
+    |+-------- Overflow
+    +--------- Negative
+    */ 
+     mem = m;
+}
+
+template <typename Variant, typename Bus>
+void BasicCPU<Variant, Bus>::Reset() {
+    InterruptDisable = 1;
+    /*
+    APU was silenced ($4015 = 0)
+    APU triangle phase is reset to 0 (i.e. outputs a value of 15, the first step of its waveform)
+    APU DPCM output ANDed with 1 (upper 6 bits cleared)
+    */
+}
+
+template <typename Variant, typename Bus>
+Byte BasicCPU<Variant, Bus>::GetStatus() const {
+    return (GetNegative() << 7) | (GetOverflow() << 6) | 0x20 | (BreakCommand << 4)
+        | (DecimalMode << 3) | (InterruptDisable << 2) | (GetZero() << 1) | GetCarry();
+}
+
+template <typename Variant, typename Bus>
+void BasicCPU<Variant, Bus>::SetStatus(Byte p) {
+    SetNegative(p & 0x80);
+    SetOverflow(p & 0x40);
+    BreakCommand = (p & 0x10) != 0;
+    DecimalMode = (p & 0x08) != 0;
+    InterruptDisable = (p & 0x04) != 0;
+    SetZero(p & 0x02);
+    SetCarry(p & 0x01);
+}
+
+template <typename Variant, typename Bus>
+u32 BasicCPU<Variant, Bus>::Op_Unknown(Word) {
+    ReportUnknownOpcode(mem->ReadByte(PC - 1));
+    return 0;
+}
+
+template <typename Variant, typename Bus>
+constexpr typename BasicCPU<Variant, Bus>::DispatchTable BasicCPU<Variant, Bus>::BuildDispatchTable() {
+    DispatchTable table{};
+    for (auto& handler : table) {
+        handler = &Dispatch<&BasicCPU::Op_Unknown>;
+    }
+#define CPU_DISPATCH_ENTRY(name, ...) table[INS_##name] = &Dispatch<&BasicCPU::Op_##name>;
+    CPU_OPCODES(CPU_DISPATCH_ENTRY)
+    if (Variant::cmos_opcodes) {
+        CPU_OPCODES_65C02(CPU_DISPATCH_ENTRY)
+    }
+#undef CPU_DISPATCH_ENTRY
+    return table;
+}
+
+template <typename Variant, typename Bus>
+const typename BasicCPU<Variant, Bus>::DispatchTable BasicCPU<Variant, Bus>::s_dispatch = BasicCPU<Variant, Bus>::BuildDispatchTable();
+
+template <typename Variant, typename Bus>
+u32 BasicCPU<Variant, Bus>::RunOneInstruction() {
+    
+    DecodedInstruction d = Decode();
+    return d.cycles + s_dispatch[d.opcode](*this, d.operand);
+}
+
+template <typename Variant, typename Bus>
+u32 BasicCPU<Variant, Bus>::RunOneInstructionSwitch() {
+    u32 cycles = Step();
+    if (cycles == 0) {
+        return Op_Unknown(0);
+    }
+    return cycles;
+}
+
+// instantiated for Mem in cpu.cpp
+extern template class BasicCPU<Nmos6502>;
+extern template class BasicCPU<Cmos65C02>;
+extern template class BasicCPU<Ricoh2A03>;
+
+#undef SET_BIT_FLAGS
+#undef SET_LOAD_REG_FLAGS
+#undef SET_LSR_FLAGS
+#undef SET_ROR_FLAGS
+#undef SET_ROL_FLAGS
+#undef SET_ASL_FLAGS
+#undef DO_ADC
+#undef ADC_EXTRA_CYCLES
+#undef RMW_ABSX_EXTRA_CYCLES
+#undef ZPI_ADDRESS
+#undef DO_LSR
+#undef DO_ROR
+#undef DO_ROL
+#undef DO_ASL
+#undef DO_RELATIVE_JUMP
+#undef OPCODE
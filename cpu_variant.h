@@ -0,0 +1,40 @@
+#pragma once
+
+/*  Variant policies for BasicCPU (see cpu.h). Everything a variant changes
+    is a compile-time constant, so a BasicCPU<Ricoh2A03> carries no decimal
+    checks at all and a BasicCPU<Nmos6502> none of the 65C02 differences.
+*/
+
+/*  The original NMOS 6502. */
+struct Nmos6502 {
+    static constexpr const char* name = "6502";
+    // ADC honours the decimal flag
+    static constexpr bool has_decimal = true;
+    // ADC takes one more cycle in decimal mode
+    static constexpr bool decimal_extra_cycle = false;
+    // the opcodes in CPU_OPCODES_65C02 are implemented
+    static constexpr bool cmos_opcodes = false;
+    // shifts and rotates with $nnnn,X take 6 cycles, 7 only on a page
+    // crossing, instead of always 7
+    static constexpr bool rmw_absx_page_penalty = false;
+};
+
+/*  The CMOS 65C02. */
+struct Cmos65C02 {
+    static constexpr const char* name = "65C02";
+    static constexpr bool has_decimal = true;
+    static constexpr bool decimal_extra_cycle = true;
+    static constexpr bool cmos_opcodes = true;
+    static constexpr bool rmw_absx_page_penalty = true;
+};
+
+/*  The Ricoh 2A03 of the NES: an NMOS 6502 whose decimal mode is
+    disconnected. The D flag can still be set and cleared but ADC ignores it.
+*/
+struct Ricoh2A03 {
+    static constexpr const char* name = "2A03";
+    static constexpr bool has_decimal = false;
+    static constexpr bool decimal_extra_cycle = false;
+    static constexpr bool cmos_opcodes = false;
+    static constexpr bool rmw_absx_page_penalty = false;
+};
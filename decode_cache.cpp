@@ -0,0 +1,67 @@
+#include "decode_cache.h"
+#include <cstring>
+
+DecodeCache::DecodeCache(Mem *m) :
+    hits(0),
+    misses(0),
+    m_mem(m)
+{
+    memset(m_pages, 0, sizeof(m_pages));
+    m_mem->SetWatcher(this);
+}
+
+DecodeCache::~DecodeCache() {
+    m_mem->SetWatcher(nullptr);
+    Clear();
+}
+
+void DecodeCache::Clear() {
+    for (auto& page : m_pages) {
+        delete[] page;
+        page = nullptr;
+    }
+}
+
+DecodedInstruction& DecodeCache::Miss(Word pc) {
+    ++misses;
+
+    DecodedInstruction*& page = m_pages[pc >> 8];
+    if (!page) {
+        page = new DecodedInstruction[0x100]();
+    }
+
+    DecodedInstruction& d = page[pc & 0xFF];
+    d = DecodeInstruction(*m_mem, pc);
+    for (Byte i = 0; i < d.length; ++i) {
+        m_mem->Watch(pc + i);
+    }
+    return d;
+}
+
+void DecodeCache::OnWrite(Word addr) {
+    // an instruction is at most 3 bytes long, so only entries starting up
+    // to 2 bytes before addr can cover it
+    for (Byte back = 0; back < 3; ++back) {
+        Word pc = addr - back;
+        DecodedInstruction* page = m_pages[pc >> 8];
+        if (page && page[pc & 0xFF].valid && page[pc & 0xFF].length > back) {
+            page[pc & 0xFF].valid = false;
+        }
+    }
+}
+
+void DecodeCache::OnRemap(Byte first, size_t count) {
+    for (size_t page = first; page < first + count; ++page) {
+        if (m_pages[page]) {
+            for (size_t i = 0; i < 0x100; ++i) {
+                m_pages[page][i].valid = false;
+            }
+        }
+    }
+    // and the entries before the first page that run onto it
+    OnWrite(Word(first * 0x100));
+}
+
+void DecodeCache::OnReload() {
+    Clear();
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "types.h"
+#include "opcodes.h"
+#include "mem.h"
+
+/*  An instruction as it was decoded from memory. */
+struct DecodedInstruction {
+    Word operand;   // operand bytes, little endian; 0 when the mode has none
+    Byte opcode;
+    Byte mode;      // AddressingMode
+    Byte length;    // opcode plus operand bytes
+    Byte cycles;    // base cycles, see CPU_OPCODES
+    bool valid;
+};
+
+/*  Reads and decodes the instruction at pc from mem, a Mem or any other
+    bus BasicCPU accepts.
+*/
+template <typename Bus>
+[[gnu::always_inline]] inline DecodedInstruction DecodeInstruction(Bus& mem, Word pc, const OpcodeTable& table = opcode_info) {
+    DecodedInstruction d;
+    d.opcode = mem.ReadByte(pc);
+    const OpcodeInfo& info = table[d.opcode];
+    d.mode = info.mode;
+    d.length = 1 + info.operand_size;
+    d.cycles = info.cycles;
+    d.valid = true;
+    switch (info.operand_size) {
+        case 1: d.operand = mem.ReadByte(pc + 1); break;
+        case 2: d.operand = mem.ReadWord(pc + 1); break;
+        default: d.operand = 0; break;
+    }
+    return d;
+}
+
+/*  Cache of decoded instructions keyed by PC.
+
+    An instruction is decoded from memory the first time it runs and served
+    from the cache afterwards. The cache watches the bytes of every
+    instruction it holds, so a write through Mem::WriteByte or
+    Mem::WriteWord to one of them drops just the affected entries, mapping
+    a page anew (a bank switch) drops the entries on it, and reloading the
+    memory drops everything.
+
+    Entries are allocated a page (256 addresses) at a time, on first use.
+*/
+class DecodeCache : public MemWatcher {
+public:
+
+    DecodeCache(Mem* );
+    ~DecodeCache();
+
+    DecodeCache(const DecodeCache&) = delete;
+    DecodeCache& operator=(const DecodeCache&) = delete;
+
+    const DecodedInstruction& Fetch(Word pc);
+
+    void Clear();
+
+    u64 hits;
+    u64 misses;
+
+    void OnWrite(Word addr) override;
+    void OnReload() override;
+    void OnRemap(Byte first, size_t count) override;
+
+private:
+
+    DecodedInstruction& Miss(Word pc);
+
+    Mem* m_mem;
+    DecodedInstruction* m_pages[0x100];
+};
+
+inline const DecodedInstruction& DecodeCache::Fetch(Word pc) {
+    DecodedInstruction* page = m_pages[pc >> 8];
+    if (page && page[pc & 0xFF].valid) {
+        ++hits;
+        return page[pc & 0xFF];
+    }
+    return Miss(pc);
+}
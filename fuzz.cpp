@@ -0,0 +1,188 @@
+#include "fuzz.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+#define FUZZ_FORK_SERVER 1
+#include <csignal>
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+u64 FuzzCPU::RunCovered(Word stop_pc, u64 cycle_budget, Byte* map, bool& unknown) {
+    // On a copy whose address never escapes, as in RunUntil.
+    FuzzCPU cpu(*this);
+    u64 cycles = 0;
+    u32 c = 1;
+    Word previous = 0;
+    while (cycles < cycle_budget && cpu.PC != stop_pc) {
+        Word pc = cpu.PC;
+        ++map[pc ^ previous];
+        previous = pc >> 1;
+        c = cpu.Step();
+        if (c == 0) {
+            break;
+        }
+        cycles += c;
+    }
+    *this = cpu;
+    unknown = c == 0;
+    return cycles;
+}
+
+Fuzzer::Fuzzer(const FuzzConfig& config) :
+    config(config),
+    status(FUZZ_STOPPED),
+    cycles(0),
+    PC(0),
+    runs(0),
+    m_cpu(&m_mem),
+    m_entry(config.entry),
+    m_own_map(new Byte[map_size]()),
+    m_serving(SERVE_NONE),
+    m_loops(0)
+{
+    map = m_own_map;
+}
+
+Fuzzer::~Fuzzer() {
+    delete[] m_own_map;
+}
+
+void Fuzzer::LoadFromFile(const std::string& path) {
+    m_mem.LoadFromFile(path);
+    Start();
+}
+
+void Fuzzer::LoadFromData(const Byte* data, size_t num_bytes, size_t offset) {
+    m_mem.LoadFromDataAtOffset(data, num_bytes, offset);
+    Start();
+}
+
+void Fuzzer::Start() {
+    m_entry = config.entry ? config.entry : m_mem.ReadWord(0xFFFC);
+    m_mem.Snapshot();
+}
+
+FuzzStatus Fuzzer::Run(const Byte* input, size_t size) {
+    m_mem.Restore();
+    memset(map, 0, map_size);
+    size = size < config.max_input ? size : config.max_input;
+    for (size_t i = 0; i < size; ++i) {
+        m_mem.WriteByte(Word(config.input_addr + i), input[i]);
+    }
+
+    m_cpu = FuzzCPU(&m_mem);
+    m_cpu.PC = m_entry;
+    m_cpu.A = Byte(size);
+    m_cpu.X = Byte(size >> 8);
+    bool unknown;
+    cycles = m_cpu.RunCovered(config.stop_pc, config.max_cycles, map, unknown);
+    if (unknown) {
+        status = FUZZ_CRASH;
+        PC = m_cpu.PC - 1;
+    } else {
+        status = m_cpu.PC == config.stop_pc ? FUZZ_STOPPED : FUZZ_TIMEOUT;
+        PC = m_cpu.PC;
+    }
+    ++runs;
+    return status;
+}
+
+bool Fuzzer::AttachAflMap() {
+#ifdef FUZZ_FORK_SERVER
+    const char* id = getenv("__AFL_SHM_ID");
+    if (!id) {
+        return false;
+    }
+    void* shared = shmat(atoi(id), nullptr, 0);
+    if (shared == reinterpret_cast<void*>(-1)) {
+        return false;
+    }
+    map = static_cast<Byte*>(shared);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Fuzzer::ServeForks(bool persistent, int control_fd, int status_fd) {
+#ifdef FUZZ_FORK_SERVER
+    u32 hello = 0;
+    if (write(status_fd, &hello, 4) != 4) {
+        return false;
+    }
+
+    // As in AFL's own fork server: a stopped persistent child is resumed
+    // for the next input instead of forking a new one, unless afl-fuzz
+    // has killed it for taking too long.
+    pid_t child = -1;
+    bool stopped = false;
+    auto quit = [&](int code) {
+        if (stopped) {
+            kill(child, SIGKILL);
+        }
+        _exit(code);
+    };
+    for (;;) {
+        u32 was_killed;
+        if (read(control_fd, &was_killed, 4) != 4) {
+            quit(0);
+        }
+        if (stopped && was_killed) {
+            stopped = false;
+            int status;
+            if (waitpid(child, &status, 0) < 0) {
+                quit(1);
+            }
+        }
+        if (stopped) {
+            kill(child, SIGCONT);
+            stopped = false;
+        } else {
+            child = fork();
+            if (child < 0) {
+                quit(1);
+            }
+            if (child == 0) {
+                close(control_fd);
+                close(status_fd);
+                m_serving = persistent ? SERVE_PERSISTENT : SERVE_ONCE;
+                m_loops = 0;
+                return true;
+            }
+        }
+        if (write(status_fd, &child, 4) != 4) {
+            quit(1);
+        }
+        int status;
+        if (waitpid(child, &status, persistent ? WUNTRACED : 0) < 0) {
+            quit(1);
+        }
+        stopped = WIFSTOPPED(status);
+        if (write(status_fd, &status, 4) != 4) {
+            quit(1);
+        }
+    }
+#else
+    (void)persistent;
+    (void)control_fd;
+    (void)status_fd;
+    return false;
+#endif
+}
+
+bool Fuzzer::Loop(u64 count) {
+    u64 limit = m_serving == SERVE_ONCE ? 1 : count;
+    if (m_loops >= limit) {
+        return false;
+    }
+#ifdef FUZZ_FORK_SERVER
+    if (m_loops > 0 && m_serving == SERVE_PERSISTENT) {
+        raise(SIGSTOP);
+    }
+#endif
+    ++m_loops;
+    return true;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <string>
+#include "types.h"
+#include "cpu.h"
+#include "mem.h"
+
+/*  Where a fuzz input goes and how long a run lasts. */
+struct FuzzConfig {
+    Word entry = 0;             // PC each run starts at; 0 for the reset vector
+    Word stop_pc = 0;           // a run ends once PC gets here
+    u64 max_cycles = 100000;    // or once it has run this many cycles
+    Word input_addr = 0x0200;   // the input is copied here
+    size_t max_input = 0x100;   // and cut off after this many bytes
+};
+
+enum FuzzStatus : Byte {
+    FUZZ_STOPPED,       // reached stop_pc
+    FUZZ_TIMEOUT,       // ran max_cycles first
+    FUZZ_CRASH,         // hit an opcode the CPU does not know
+};
+
+/*  The CPU with a run loop for fuzzing. */
+class FuzzCPU : public CPU {
+public:
+
+    using CPU::CPU;
+
+    /*  Like RunUntil(stop_pc, cycle_budget), also counting each edge run
+        in map (see Fuzzer). An unknown opcode ends the run quietly with
+        unknown set and PC past it, as a fuzzer hits them all the time.
+    */
+    u64 RunCovered(Word stop_pc, u64 cycle_budget, Byte* map, bool& unknown);
+};
+
+/*  Runs a ROM on one fuzz input after another, recording AFL style edge
+    coverage into map.
+
+    The ROM is loaded once and memory snapshotted (see Mem::Snapshot). Each
+    Run restores just the pages the last run wrote, resets the registers,
+    copies the input to input_addr with its size in A (low byte) and X
+    (high byte), and runs from entry. So an input costs the pages it
+    dirties rather than a reload.
+
+    Every instruction counts the edge from the one before it in map, at
+    map[PC ^ previous PC >> 1] as AFL's instrumentation does, so map has an
+    entry for every pair of 16 bit PCs without hashing.
+
+    Under afl-fuzz, AttachAflMap and ServeForks below let the same Fuzzer
+    run as an instrumented target with a fork server (see tools/fuzz.cpp).
+*/
+class Fuzzer {
+public:
+
+    static constexpr size_t map_size = 0x10000;
+
+    explicit Fuzzer(const FuzzConfig& config);
+    ~Fuzzer();
+
+    Fuzzer(const Fuzzer&) = delete;
+    Fuzzer& operator=(const Fuzzer&) = delete;
+
+    /*  Load the ROM every run starts from and snapshot it. */
+    void LoadFromFile(const std::string& path);
+    void LoadFromData(const Byte* data, size_t num_bytes, size_t offset = 0);
+
+    /*  Clears map and runs input from the snapshot. */
+    FuzzStatus Run(const Byte* input, size_t size);
+
+    /*  Points map at afl-fuzz's shared memory when __AFL_SHM_ID is set.
+        False, keeping the Fuzzer's own map, otherwise.
+    */
+    bool AttachAflMap();
+
+    /*  AFL's fork server on control_fd and status_fd, the descriptors
+        afl-fuzz opens as 198 and 199. The calling process becomes the
+        server and only ever returns inside a child that afl-fuzz asked
+        for, which runs inputs and exits; a child that crashes should
+        abort() so afl-fuzz sees the signal. With persistent set, a child
+        may run several inputs, stopping between them with Loop.
+
+        Returns false straight away when no fork server is listening, and
+        the caller runs a single input itself.
+    */
+    bool ServeForks(bool persistent, int control_fd = 198, int status_fd = 199);
+
+    /*  For a child's persistent loop, like AFL's __AFL_LOOP: true for the
+        first `count` calls, stopping the child with SIGSTOP before each
+        one after the first while it runs under ServeForks, so the server
+        can report the last input and resume it with the next.
+    */
+    bool Loop(u64 count);
+
+    FuzzConfig config;
+    Byte* map;
+
+    // the last run
+    FuzzStatus status;
+    u64 cycles;
+    Word PC;            // stop_pc, the next instruction or the unknown opcode
+
+    u64 runs;       // Run calls so far
+
+private:
+
+    void Start();
+
+    Mem m_mem;
+    FuzzCPU m_cpu;
+    Word m_entry;
+    Byte* m_own_map;
+
+    enum Serving : Byte { SERVE_NONE, SERVE_ONCE, SERVE_PERSISTENT };
+    Serving m_serving;  // what ServeForks made this process
+    u64 m_loops;
+};
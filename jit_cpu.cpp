@@ -0,0 +1,574 @@
+#include "jit_cpu.h"
+#include "decode_cache.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define JIT_X86_64 1
+#include <sys/mman.h>
+#endif
+
+// size of the executable buffer; everything is flushed when it fills up
+static constexpr size_t code_size = 4 << 20;
+// room left for one more block: 64 instructions plus their exits
+static constexpr size_t max_block_code = 8192;
+static constexpr size_t max_blocks = 16384;
+static constexpr size_t max_block_ops = 64;
+
+JitCPU::JitCPU(Mem *m) :
+    CPU(m),
+    jit_threshold(16),
+    jit_compiled(0),
+    jit_executed(0),
+    jit_interpreted(0),
+    m_blocks(new Block[max_blocks]),
+    m_block_count(0),
+    m_code(nullptr),
+    m_code_used(0),
+    m_code_map(new Byte[Mem::max_mem_size]())
+{
+    memset(m_pages, 0, sizeof(m_pages));
+#ifdef JIT_X86_64
+    void* code = mmap(nullptr, code_size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code != MAP_FAILED) {
+        m_code = (Byte*)code;
+    }
+#endif
+    mem->SetWatcher(this);
+}
+
+JitCPU::~JitCPU() {
+    mem->SetWatcher(nullptr);
+    for (auto page : m_pages) {
+        delete[] page;
+    }
+#ifdef JIT_X86_64
+    if (m_code) {
+        munmap(m_code, code_size);
+    }
+#endif
+    delete[] m_blocks;
+    delete[] m_code_map;
+}
+
+void JitCPU::Flush() {
+    for (auto& page : m_pages) {
+        delete[] page;
+        page = nullptr;
+    }
+    m_block_count = 0;
+    m_code_used = 0;
+    memset(m_code_map, 0, Mem::max_mem_size);
+    // drops the watches on the old code
+    mem->SetWatcher(this);
+}
+
+JitCPU::Entry& JitCPU::EntryFor(Word pc) {
+    Entry*& page = m_pages[pc >> 8];
+    if (!page) {
+        page = new Entry[0x100]();
+    }
+    return page[pc & 0xFF];
+}
+
+#ifdef JIT_X86_64
+
+namespace {
+
+enum Reg {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R8 = 8, R9 = 9, R10 = 10, R11 = 11,
+};
+
+/*  Host register assignment inside a block. Every register holds a value
+    zero-extended to 32 bits: 0-255 for the 6502 registers, 0 or 1 for the
+    flags. Nothing is ever called from a block, so caller-saved registers
+    are safe to hold state; rbx and rbp are saved in the prologue.
+*/
+static constexpr Reg REG_STATE = RDI;
+static constexpr Reg REG_A = R8;
+static constexpr Reg REG_X = R9;
+static constexpr Reg REG_Y = R10;
+static constexpr Reg REG_C = RCX;
+static constexpr Reg REG_Z = RDX;
+static constexpr Reg REG_N = RSI;
+static constexpr Reg REG_V = RBP;
+static constexpr Reg REG_OPERAND = R11;
+
+static constexpr Byte CC_E = 0x4;
+static constexpr Byte CC_NE = 0x5;
+static constexpr Byte SETE = 0x94;
+static constexpr Byte SETS = 0x98;
+
+static constexpr Byte OP_ADD = 0x01;
+static constexpr Byte OP_OR = 0x09;
+static constexpr Byte OP_AND = 0x21;
+static constexpr Byte OP_XOR = 0x31;
+static constexpr Byte OP_MOV = 0x89;
+static constexpr Byte OP_TEST = 0x85;
+
+#define STATE_OFFSET(field) Byte(offsetof(JitCPU::State, field))
+
+/*  Just enough of an x86-64 assembler for the translations below. */
+class Emitter {
+public:
+
+    Emitter(Byte* code) : m_start(code), m_p(code) {}
+
+    size_t Size() const { return m_p - m_start; }
+
+    // r32 = imm32
+    void MovImm(Reg r, u32 imm) { Rex(false, 0, r, false); Emit(0xB8 + (r & 7)); Emit32(imm); }
+    // OP_* r/m32(dst), r32(src)
+    void Alu(Byte op, Reg dst, Reg src) { Rex(false, src, dst, false); Emit(op); ModRM(3, src, dst); }
+    // movzx r32, r8
+    void Movzx8(Reg dst, Reg src) { Rex(false, dst, src, true); Emit(0x0F); Emit(0xB6); ModRM(3, dst, src); }
+    // test r8, r8
+    void Test8(Reg r) { Rex(false, r, r, true); Emit(0x84); ModRM(3, r, r); }
+    // setcc r8
+    void Setcc(Byte cc, Reg r) { Rex(false, 0, r, true); Emit(0x0F); Emit(cc); ModRM(3, 0, r); }
+    // shl (ext 4) / shr (ext 5) r32, imm8
+    void Shift(int ext, Reg r, Byte n) { Rex(false, 0, r, false); Emit(0xC1); ModRM(3, ext, r); Emit(n); }
+    // and r32, imm8
+    void AndImm(Reg r, Byte imm) { Rex(false, 0, r, false); Emit(0x83); ModRM(3, 4, r); Emit(imm); }
+    // not r32
+    void Not(Reg r) { Rex(false, 0, r, false); Emit(0xF7); ModRM(3, 2, r); }
+
+    // mov r64, [state + offset]
+    void LoadStatePtr(Reg dst, Byte offset) { Rex(true, dst, REG_STATE, false); Emit(0x8B); ModRM(1, dst, REG_STATE); Emit(offset); }
+    // movzx r32, byte [state + offset]
+    void LoadState8(Reg dst, Byte offset) { Rex(false, dst, REG_STATE, false); Emit(0x0F); Emit(0xB6); ModRM(1, dst, REG_STATE); Emit(offset); }
+    // mov byte [state + offset], r8
+    void StoreState8(Byte offset, Reg src) { Rex(false, src, REG_STATE, true); Emit(0x88); ModRM(1, src, REG_STATE); Emit(offset); }
+    // mov byte [state + offset], imm8
+    void StoreStateImm8(Byte offset, Byte imm) { Emit(0xC6); ModRM(1, 0, REG_STATE); Emit(offset); Emit(imm); }
+    // mov word [state + offset], imm16
+    void StoreStateImm16(Byte offset, Word imm) { Emit(0x66); Emit(0xC7); ModRM(1, 0, REG_STATE); Emit(offset); Emit(imm & 0xFF); Emit(imm >> 8); }
+
+    // movzx r32, byte [rax + disp32]
+    void LoadMem8(Reg dst, u32 disp) { Rex(false, dst, RAX, false); Emit(0x0F); Emit(0xB6); ModRM(2, dst, RAX); Emit32(disp); }
+    // mov byte [rax + disp32], r8
+    void StoreMem8(u32 disp, Reg src) { Rex(false, src, RAX, true); Emit(0x88); ModRM(2, src, RAX); Emit32(disp); }
+    // cmp byte [rax + disp32], 0
+    void CmpMem8Zero(u32 disp) { Emit(0x80); ModRM(2, 7, RAX); Emit32(disp); Emit(0); }
+
+    // jcc rel8 / rel32 to a later Bind
+    Byte* Jcc8(Byte cc) { Emit(0x70 | cc); Emit(0); return m_p - 1; }
+    Byte* Jcc32(Byte cc) { Emit(0x0F); Emit(0x80 | cc); Emit32(0); return m_p - 4; }
+    void Bind8(Byte* at) { *at = Byte(m_p - (at + 1)); }
+    void Bind32(Byte* at) { int32_t rel = int32_t(m_p - (at + 4)); memcpy(at, &rel, 4); }
+
+    void Push(Reg r) { Rex(false, 0, r, false); Emit(0x50 | (r & 7)); }
+    void Pop(Reg r) { Rex(false, 0, r, false); Emit(0x58 | (r & 7)); }
+    void Ret() { Emit(0xC3); }
+
+private:
+
+    void Emit(Byte b) { *m_p++ = b; }
+    void Emit32(u32 v) { memcpy(m_p, &v, 4); m_p += 4; }
+    void ModRM(int mod, int reg, int rm) { Emit(Byte((mod << 6) | ((reg & 7) << 3) | (rm & 7))); }
+    // force is needed to address spl/bpl/sil/dil as byte registers
+    void Rex(bool w, int reg, int rm, bool force) {
+        Byte rex = 0x40 | (w << 3) | ((reg >> 3) << 2) | (rm >> 3);
+        if (rex != 0x40 || force) {
+            Emit(rex);
+        }
+    }
+
+    Byte* m_start;
+    Byte* m_p;
+};
+
+/*  Translates one block. Tracks the cycles spent so far on the path being
+    emitted and the longest path seen by any exit.
+*/
+class BlockCompiler {
+public:
+
+    BlockCompiler(Byte* code) : e(code), cycles(0), max_cycles(0), uses_adc(false) {}
+
+    Emitter e;
+    u32 cycles;
+    u32 max_cycles;
+    bool uses_adc;
+
+    void Prologue() {
+        e.Push(RBX);
+        e.Push(RBP);
+        e.LoadState8(REG_A, STATE_OFFSET(A));
+        e.LoadState8(REG_X, STATE_OFFSET(X));
+        e.LoadState8(REG_Y, STATE_OFFSET(Y));
+        e.LoadState8(REG_C, STATE_OFFSET(C));
+        e.LoadState8(REG_Z, STATE_OFFSET(Z));
+        e.LoadState8(REG_N, STATE_OFFSET(N));
+        e.LoadState8(REG_V, STATE_OFFSET(V));
+    }
+
+    /*  Leaves the block with PC = pc, returning exit_cycles. */
+    void Exit(Word pc, u32 exit_cycles) {
+        if (exit_cycles > max_cycles) {
+            max_cycles = exit_cycles;
+        }
+        e.StoreStateImm16(STATE_OFFSET(PC), pc);
+        e.MovImm(RAX, exit_cycles);
+        e.StoreState8(STATE_OFFSET(A), REG_A);
+        e.StoreState8(STATE_OFFSET(X), REG_X);
+        e.StoreState8(STATE_OFFSET(Y), REG_Y);
+        e.StoreState8(STATE_OFFSET(C), REG_C);
+        e.StoreState8(STATE_OFFSET(Z), REG_Z);
+        e.StoreState8(STATE_OFFSET(N), REG_N);
+        e.StoreState8(STATE_OFFSET(V), REG_V);
+        e.Pop(RBP);
+        e.Pop(RBX);
+        e.Ret();
+    }
+
+    void SetNZ(Reg r) {
+        e.Test8(r);
+        e.Setcc(SETE, REG_Z);
+        e.Setcc(SETS, REG_N);
+    }
+
+    void SetNZ(Byte v) {
+        e.MovImm(REG_Z, v == 0);
+        e.MovImm(REG_N, v >> 7);
+    }
+
+    /*  Loads an immediate, zero page or absolute operand into dst. */
+    void Load(Reg dst, const DecodedInstruction& d) {
+        if (d.mode == AM_IMM) {
+            e.MovImm(dst, d.operand);
+        } else {
+            e.LoadStatePtr(RAX, STATE_OFFSET(data));
+            e.LoadMem8(dst, d.operand);
+        }
+    }
+
+    /*  Stores src to a zero page or absolute address. If the address holds
+        translated code, leaves the block before the store instead, so the
+        interpreter does the write and the code gets invalidated.
+    */
+    void Store(Reg src, const DecodedInstruction& d, Word pc) {
+        e.LoadStatePtr(RAX, STATE_OFFSET(code_map));
+        e.CmpMem8Zero(d.operand);
+        Byte* no_code = e.Jcc8(CC_E);
+        e.StoreStateImm8(STATE_OFFSET(side_exit), 1);
+        Exit(pc, cycles);
+        e.Bind8(no_code);
+        e.LoadStatePtr(RAX, STATE_OFFSET(data));
+        e.StoreMem8(d.operand, src);
+    }
+
+    /*  Same flags and result as DO_ADD/SET_ADD_FLAGS in binary mode. */
+    void Adc() {
+        // V = (v1 < 0x80) && (v2 < 0x80) && (v1 + v2 >= 0x80)
+        e.Alu(OP_MOV, RAX, REG_A);
+        e.Alu(OP_MOV, RBX, RAX);
+        e.Alu(OP_ADD, RBX, REG_OPERAND);
+        e.Alu(OP_OR, RAX, REG_OPERAND);
+        e.Not(RAX);
+        e.Alu(OP_AND, RAX, RBX);
+        e.Shift(5, RAX, 7);
+        e.AndImm(RAX, 1);
+        e.Alu(OP_MOV, REG_V, RAX);
+        // A = v1 + v2 + C, C = bit 8
+        e.Alu(OP_ADD, REG_A, REG_OPERAND);
+        e.Alu(OP_ADD, REG_A, REG_C);
+        e.Alu(OP_MOV, REG_C, REG_A);
+        e.Shift(5, REG_C, 8);
+        e.Movzx8(REG_A, REG_A);
+        SetNZ(REG_A);
+    }
+
+    /*  Emits both exits of a branch. */
+    void Branch(Reg flag, bool taken_if_set, Word pc, const DecodedInstruction& d) {
+        Word next = pc + d.length;
+        Byte r = Byte(d.operand);
+        Word target = (r & 0x80) ? Word(next - (0x100 - r)) : Word(next + r);
+        bool page_crossed = (target & 0x100) != (next & 0x100);
+
+        e.Alu(OP_TEST, flag, flag);
+        Byte* not_taken = e.Jcc32(taken_if_set ? CC_E : CC_NE);
+        Exit(target, cycles + d.cycles + (page_crossed ? 2 : 1));
+        e.Bind32(not_taken);
+        Exit(next, cycles + d.cycles);
+    }
+
+    /*  Emits one instruction. Returns false, emitting nothing, for
+        instructions that are not translated.
+    */
+    bool Translate(const DecodedInstruction& d, Word pc) {
+        switch (d.opcode) {
+            case INS_LDA_IM: Load(REG_A, d); SetNZ(Byte(d.operand)); break;
+            case INS_LDX_IM: Load(REG_X, d); SetNZ(Byte(d.operand)); break;
+            case INS_LDY_IM: Load(REG_Y, d); SetNZ(Byte(d.operand)); break;
+            case INS_LDA_ZP:
+            case INS_LDA_ABS: Load(REG_A, d); SetNZ(REG_A); break;
+            case INS_LDX_ZP:
+            case INS_LDX_ABS: Load(REG_X, d); SetNZ(REG_X); break;
+            case INS_LDY_ZP:
+            case INS_LDY_ABS: Load(REG_Y, d); SetNZ(REG_Y); break;
+
+            case INS_STA_ZP:
+            case INS_STA_ABS: Store(REG_A, d, pc); break;
+            case INS_STX_ZP:
+            case INS_STX_ABS: Store(REG_X, d, pc); break;
+            case INS_STY_ZP:
+            case INS_STY_ABS: Store(REG_Y, d, pc); break;
+
+            case INS_AND_IM:
+            case INS_AND_ZP:
+            case INS_AND_ABS:
+                Load(REG_OPERAND, d);
+                e.Alu(OP_AND, REG_A, REG_OPERAND);
+                SetNZ(REG_A);
+                break;
+            case INS_ADC_IM:
+            case INS_ADC_ZP:
+            case INS_ADC_ABS:
+                uses_adc = true;
+                Load(REG_OPERAND, d);
+                Adc();
+                break;
+
+            case INS_BIT_ZP:
+            case INS_BIT_ABS:
+                Load(REG_OPERAND, d);
+                e.Alu(OP_MOV, REG_N, REG_OPERAND);
+                e.Shift(5, REG_N, 7);
+                e.Alu(OP_MOV, REG_V, REG_OPERAND);
+                e.Shift(5, REG_V, 6);
+                e.AndImm(REG_V, 1);
+                e.Alu(OP_MOV, RAX, REG_OPERAND);
+                e.Alu(OP_AND, RAX, REG_A);
+                e.Test8(RAX);
+                e.Setcc(SETE, REG_Z);
+                break;
+
+            case INS_ASL_A:
+                e.Alu(OP_MOV, REG_C, REG_A);
+                e.Shift(5, REG_C, 7);
+                e.Alu(OP_ADD, REG_A, REG_A);
+                e.Movzx8(REG_A, REG_A);
+                SetNZ(REG_A);
+                break;
+            case INS_LSR_A:
+                e.Alu(OP_MOV, REG_C, REG_A);
+                e.AndImm(REG_C, 1);
+                e.Shift(5, REG_A, 1);
+                SetNZ(REG_A);
+                break;
+            case INS_ROL_A:
+                e.Alu(OP_MOV, RAX, REG_A);
+                e.Shift(5, RAX, 7);
+                e.Alu(OP_ADD, REG_A, REG_A);
+                e.Alu(OP_OR, REG_A, REG_C);
+                e.Movzx8(REG_A, REG_A);
+                e.Alu(OP_MOV, REG_C, RAX);
+                SetNZ(REG_A);
+                break;
+            case INS_ROR_A:
+                e.Alu(OP_MOV, RAX, REG_A);
+                e.AndImm(RAX, 1);
+                e.Shift(5, REG_A, 1);
+                e.Shift(4, REG_C, 7);
+                e.Alu(OP_OR, REG_A, REG_C);
+                e.Alu(OP_MOV, REG_C, RAX);
+                SetNZ(REG_A);
+                break;
+
+            case INS_TAX: e.Alu(OP_MOV, REG_X, REG_A); SetNZ(REG_X); break;
+            case INS_TXA: e.Alu(OP_MOV, REG_A, REG_X); SetNZ(REG_A); break;
+            case INS_TAY: e.Alu(OP_MOV, REG_Y, REG_A); SetNZ(REG_Y); break;
+            case INS_TYA: e.Alu(OP_MOV, REG_A, REG_Y); SetNZ(REG_A); break;
+            case INS_TSX: e.LoadState8(REG_X, STATE_OFFSET(SP)); SetNZ(REG_X); break;
+            case INS_TXS: e.StoreState8(STATE_OFFSET(SP), REG_X); SetNZ(REG_X); break;
+
+            case INS_CLC: e.Alu(OP_XOR, REG_C, REG_C); break;
+            case INS_SEC: e.MovImm(REG_C, 1); break;
+            case INS_CLI: e.StoreStateImm8(STATE_OFFSET(I), 0); break;
+            case INS_SEI: e.StoreStateImm8(STATE_OFFSET(I), 1); break;
+
+            case INS_BMI: Branch(REG_N, true, pc, d); break;
+            case INS_BPL: Branch(REG_N, false, pc, d); break;
+            case INS_BEQ: Branch(REG_Z, true, pc, d); break;
+            case INS_BNE: Branch(REG_Z, false, pc, d); break;
+            case INS_BCS: Branch(REG_C, true, pc, d); break;
+            case INS_BCC: Branch(REG_C, false, pc, d); break;
+            case INS_BVS: Branch(REG_V, true, pc, d); break;
+            case INS_BVC: Branch(REG_V, false, pc, d); break;
+
+            default:
+                return false;
+        }
+        cycles += d.cycles;
+        return true;
+    }
+};
+
+}
+
+JitCPU::Block* JitCPU::Compile(Word pc) {
+    if (m_code_used + max_block_code > code_size || m_block_count == max_blocks) {
+        Flush();
+    }
+
+    BlockCompiler compiler(m_code + m_code_used);
+    compiler.Prologue();
+
+    Word addr = pc;
+    size_t ops = 0;
+    bool ended = false;
+    while (ops < max_block_ops) {
+        DecodedInstruction d = DecodeInstruction(*mem, addr);
+        if (!compiler.Translate(d, addr)) {
+            break;
+        }
+        ++ops;
+        addr += d.length;
+        if (d.mode == AM_REL) {
+            ended = true;
+            break;
+        }
+    }
+
+    Entry& entry = EntryFor(pc);
+    if (ops == 0) {
+        // tried again once the instruction is written (see OnWrite)
+        entry.rejected = true;
+        DecodedInstruction d = DecodeInstruction(*mem, pc);
+        for (Byte i = 0; i < d.length; ++i) {
+            mem->Watch(pc + i);
+        }
+        return nullptr;
+    }
+    if (!ended) {
+        compiler.Exit(addr, compiler.cycles);
+    }
+
+    Block& block = m_blocks[m_block_count++];
+    block.fn = (BlockFn)(m_code + m_code_used);
+    block.start = pc;
+    block.end = addr;
+    block.max_cycles = compiler.max_cycles;
+    block.uses_adc = compiler.uses_adc;
+    m_code_used += compiler.e.Size();
+    ++jit_compiled;
+
+    for (Word a = pc; a != addr; ++a) {
+        m_code_map[a] = 1;
+        mem->Watch(a);
+    }
+    entry.block = &block;
+    return &block;
+}
+
+#else
+
+JitCPU::Block* JitCPU::Compile(Word pc) {
+    EntryFor(pc).rejected = true;
+    return nullptr;
+}
+
+#endif
+
+u32 JitCPU::Execute(const Block& block, bool& side_exit) {
+    State s;
+    s.data = mem->m_data;
+    s.code_map = m_code_map;
+    s.A = A;
+    s.X = X;
+    s.Y = Y;
+    s.SP = SP;
+    s.C = GetCarry();
+    s.Z = GetZero();
+    s.N = GetNegative();
+    s.V = GetOverflow();
+    s.I = InterruptDisable;
+    s.side_exit = 0;
+    s.PC = PC;
+
+    u32 cycles = block.fn(&s);
+    ++jit_executed;
+
+    A = s.A;
+    X = s.X;
+    Y = s.Y;
+    SP = s.SP;
+    SetCarry(s.C);
+    SetZero(s.Z);
+    SetNegative(s.N);
+    SetOverflow(s.V);
+    InterruptDisable = s.I;
+    PC = s.PC;
+    side_exit = s.side_exit;
+    return cycles;
+}
+
+u64 JitCPU::Run(u64 cycle_budget) {
+    u64 cycles = 0;
+    bool native = m_code && mem->m_data && !(Mem::trace_enabled && mem->trace) && mem->IsPlainRAM()
+        && !mem->HasSnapshot();
+
+    while (cycles < cycle_budget) {
+        bool side_exit = false;
+        if (native) {
+            Entry& entry = EntryFor(PC);
+            Block* block = entry.block;
+            if (!block && !entry.rejected && ++entry.count >= jit_threshold) {
+                block = Compile(PC);
+            }
+            if (block && block->max_cycles <= cycle_budget - cycles && !(block->uses_adc && DecimalMode)) {
+                cycles += Execute(*block, side_exit);
+                if (!side_exit) {
+                    continue;
+                }
+            }
+        }
+
+        // interpret up to and including the next branch; after a side exit
+        // just the store that caused it
+        for (;;) {
+            DecodedInstruction d = Decode();
+            u32 c = d.cycles + s_dispatch[d.opcode](*this, d.operand);
+            ++jit_interpreted;
+            if (!opcode_info[d.opcode].implemented) {
+                return cycles;
+            }
+            cycles += c;
+            if (side_exit || d.mode == AM_REL || cycles >= cycle_budget) {
+                break;
+            }
+        }
+    }
+    return cycles;
+}
+
+void JitCPU::OnWrite(Word addr) {
+    // a rejected instruction is at most 3 bytes long, so only entries
+    // starting up to 2 bytes before addr can cover it
+    for (Byte back = 0; back < 3; ++back) {
+        Word pc = addr - back;
+        Entry* page = m_pages[pc >> 8];
+        if (page && page[pc & 0xFF].rejected) {
+            page[pc & 0xFF].rejected = false;
+            page[pc & 0xFF].count = 0;
+        }
+    }
+    for (size_t i = 0; i < m_block_count; ++i) {
+        Block& block = m_blocks[i];
+        bool covered = block.start <= block.end
+            ? (addr >= block.start && addr < block.end)
+            : (addr >= block.start || addr < block.end);
+        if (covered) {
+            Entry& entry = EntryFor(block.start);
+            if (entry.block == &block) {
+                entry.block = nullptr;
+                entry.count = 0;
+            }
+        }
+    }
+}
+
+void JitCPU::OnReload() {
+    Flush();
+}
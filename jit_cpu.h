@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include "cpu.h"
+#include "mem.h"
+
+/*  CPU execution engine that compiles hot code to x86-64 machine code.
+
+    The engine interprets like CPU::Run and counts how often each block
+    start (the PC after a branch, or where a run begins) is reached. Once a
+    PC has been reached jit_threshold times, the straight-line code from
+    there up to and including the next branch is translated into a native
+    function in an mmap'd executable buffer. A, X, Y and the C, Z, N and V
+    flags live in host registers for the whole block and memory is
+    accessed directly.
+
+    Only a subset of instructions is translated: loads, stores and AND/ADC
+    with immediate, zero page or absolute operands, BIT, the accumulator shifts,
+    register transfers, CLC/SEC/CLI/SEI and the branches. A block ends just
+    before anything else and the interpreter takes over from there. A block
+    containing ADC is only entered while the decimal flag is clear, and a
+    block is only entered when its longest path fits in the remaining cycle
+    budget, so cycle counts match CPU::Run exactly.
+
+    Translated code is dropped when one of its bytes is written, whether
+    through Mem or by a store in translated code. The engine is the Mem's
+    watcher, so like BlockCPU it cannot share a Mem with a DecodeCache and
+    ignores decode_cache. On hosts other than x86-64, while a memory trace
+    is set (see Mem::trace), when the Mem maps anything but plain RAM
+    (see Mem::IsPlainRAM) or while it holds a snapshot whose dirty pages
+    translated stores would not mark, everything is interpreted.
+*/
+class JitCPU : public CPU, public MemWatcher {
+public:
+
+    JitCPU(Mem* );
+    ~JitCPU();
+
+    JitCPU(const JitCPU&) = delete;
+    JitCPU& operator=(const JitCPU&) = delete;
+
+    /*  Same contract as CPU::Run, with identical cycle counts. */
+    u64 Run(u64 cycle_budget);
+
+    /*  Drops all translated code and execution counts. */
+    void Flush();
+
+    u32 jit_threshold;      // times a block start is reached before it is compiled
+
+    u64 jit_compiled;       // blocks translated
+    u64 jit_executed;       // times translated code was entered
+    u64 jit_interpreted;    // instructions run by the interpreter
+
+    void OnWrite(Word addr) override;
+    void OnReload() override;
+
+    /*  Register file handed to translated code. */
+    struct State {
+        Byte* data;         // Mem::m_data
+        Byte* code_map;     // non-zero for every byte of translated code
+        Byte A, X, Y, SP;
+        Byte C, Z, N, V;
+        Byte I;
+        Byte side_exit;     // set when a store into translated code left the block
+        Word PC;
+    };
+
+private:
+
+    typedef u32 (*BlockFn)(State*);
+
+    struct Block {
+        BlockFn fn;
+        Word start;
+        Word end;
+        u32 max_cycles;     // longest path through the block
+        bool uses_adc;
+    };
+
+    struct Entry {
+        Block* block;
+        u32 count;
+        bool rejected;      // nothing at this PC can be translated until it is written
+    };
+
+    Entry& EntryFor(Word pc);
+    Block* Compile(Word pc);
+    u32 Execute(const Block& block, bool& side_exit);
+
+    Entry* m_pages[0x100];
+    Block* m_blocks;
+    size_t m_block_count;
+    Byte* m_code;
+    size_t m_code_used;
+    Byte* m_code_map;
+};
@@ -0,0 +1,39 @@
+#include "machine.h"
+#include <cstring>
+
+typedef BasicCPU<Nmos6502, Machine> MachineCPU;
+
+void Machine::LoadFromData(const Byte* data, size_t num_bytes, size_t offset) {
+    memset(ram, 0, sizeof(ram));
+    if (offset < sizeof(ram)) {
+        memcpy(ram + offset, data, num_bytes < sizeof(ram) - offset ? num_bytes : sizeof(ram) - offset);
+    }
+}
+
+void Machine::LoadImage(const MemImage& image) {
+    memcpy(ram, image.Page(0), sizeof(ram));
+}
+
+u32 Machine::RunOneInstruction() {
+    MachineCPU cpu(this);
+    Store(cpu);
+    u32 cycles = cpu.RunOneInstruction();
+    Load(cpu);
+    return cycles;
+}
+
+u64 Machine::Run(u64 cycle_budget) {
+    MachineCPU cpu(this);
+    Store(cpu);
+    u64 cycles = cpu.Run(cycle_budget);
+    Load(cpu);
+    return cycles;
+}
+
+u64 Machine::RunUntil(Word stop_pc, u64 cycle_budget) {
+    MachineCPU cpu(this);
+    Store(cpu);
+    u64 cycles = cpu.RunUntil(stop_pc, cycle_budget);
+    Load(cpu);
+    return cycles;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <type_traits>
+#include "types.h"
+#include "cpu.h"
+#include "mem.h"
+
+/*  A CPU's registers with the flags packed as GetStatus returns them, so
+    the state can be kept and copied apart from the CPU and its bus. The
+    defaults are the CPU's power on state.
+*/
+struct Registers {
+    Word PC = 0;
+    Byte A = 0, X = 0, Y = 0;
+    Byte SP = 0xFD;
+    Byte P = 0x24;
+
+    /*  Copies cpu's registers and flags in. */
+    template <typename Cpu>
+    void Load(const Cpu& cpu) {
+        PC = cpu.PC;
+        A = cpu.A;
+        X = cpu.X;
+        Y = cpu.Y;
+        SP = cpu.SP;
+        P = cpu.GetStatus();
+    }
+
+    /*  Copies them back into cpu. */
+    template <typename Cpu>
+    void Store(Cpu& cpu) const {
+        cpu.PC = PC;
+        cpu.A = A;
+        cpu.X = X;
+        cpu.Y = Y;
+        cpu.SP = SP;
+        cpu.SetStatus(P);
+    }
+};
+
+/*  A whole machine as one value: the registers and 64 KB of RAM in a
+    single cache-aligned block with no pointers in it, so it can be copied,
+    moved and stored in containers like any other value, and copying it is
+    one memcpy.
+
+    The machine is its own bus (see BasicCPU), so Run builds a CPU on the
+    stack pointing at ram and every access inside the run loop is an
+    inlined index into it. There is no page table, so nothing can be
+    mapped: for ROM, I/O, watches or snapshots use a Mem.
+*/
+class alignas(64) Machine : public Registers {
+public:
+
+    /*  All RAM zero. */
+    Machine() : ram() {}
+
+    /*  Copies data to offset and zeroes the rest, like
+        Mem::LoadFromDataAtOffset.
+    */
+    void LoadFromData(const Byte* data, size_t num_bytes, size_t offset = 0);
+    void LoadImage(const MemImage& image);
+
+    Byte ReadByte(Word addr) { return ram[addr]; }
+    Byte WriteByte(Word addr, Byte data) { return ram[addr] = data; }
+    Word ReadWord(Word addr) { return ram[addr] | ram[Word(addr + 1)] << 8; }
+
+    /*  As the CPU functions of the same name. Each call packs and unpacks
+        the flags once, so stepping with RunOneInstruction is slower than
+        running a budget.
+    */
+    u32 RunOneInstruction();
+    u64 Run(u64 cycle_budget);
+    u64 RunUntil(Word stop_pc, u64 cycle_budget = ~u64(0));
+
+    alignas(64) Byte ram[Mem::max_mem_size];
+};
+
+static_assert(std::is_trivially_copyable<Machine>::value, "a Machine must copy as one memcpy");
@@ -0,0 +1,139 @@
+#include "mapper.h"
+#include <cstring>
+
+static constexpr Word prg_window = 0x8000;
+static constexpr size_t prg_window_size = 0x8000;
+
+Mapper::Mapper(const Byte* prg, size_t prg_size) :
+    m_mem(nullptr)
+{
+    size_t size = prg_window_size;
+    while (size < prg_size) {
+        size *= 2;
+    }
+    auto mirrored = std::make_shared<std::vector<Byte>>(size);
+    for (size_t offset = 0; prg_size && offset < size; offset += prg_size) {
+        memcpy(mirrored->data() + offset, prg, offset + prg_size < size ? prg_size : size - offset);
+    }
+    m_prg = mirrored;
+}
+
+void Mapper::Attach(Mem* mem) {
+    m_mem = mem;
+    Reset();
+}
+
+std::unique_ptr<MemDevice> Mapper::Fork(Mem* mem) {
+    // mem already maps the banks this mapper has switched in
+    std::unique_ptr<Mapper> copy = Clone();
+    copy->m_mem = mem;
+    return copy;
+}
+
+void Mapper::MapPrg(Word addr, size_t size, size_t bank) {
+    size_t offset = (bank & LastBank(size)) * size;
+    m_mem->MapBank(addr >> 8, size / Mem::page_size, m_prg->data() + offset, this);
+}
+
+std::unique_ptr<Mapper> Mapper::Create(u32 number, const Byte* prg, size_t prg_size) {
+    switch (number) {
+        case 0: return std::unique_ptr<Mapper>(new NromMapper(prg, prg_size));
+        case 1: return std::unique_ptr<Mapper>(new Mmc1Mapper(prg, prg_size));
+        case 2: return std::unique_ptr<Mapper>(new UxromMapper(prg, prg_size));
+        case 7: return std::unique_ptr<Mapper>(new AxromMapper(prg, prg_size));
+        case 66: return std::unique_ptr<Mapper>(new GxromMapper(prg, prg_size));
+    }
+    return nullptr;
+}
+
+std::unique_ptr<Mapper> Mapper::FromINes(const Byte* file, size_t size) {
+    constexpr size_t header_size = 16;
+    constexpr size_t trainer_size = 512;
+    if (size < header_size || memcmp(file, "NES\x1A", 4) != 0) {
+        return nullptr;
+    }
+    size_t prg_size = file[4] * size_t(0x4000);
+    size_t prg_offset = header_size + (file[6] & 0x04 ? trainer_size : 0);
+    u32 number = (file[6] >> 4) | (file[7] & 0xF0);
+    if (prg_size == 0 || prg_offset + prg_size > size) {
+        return nullptr;
+    }
+    return Create(number, file + prg_offset, prg_size);
+}
+
+void NromMapper::Reset() {
+    MapPrg(prg_window, prg_window_size, 0);
+}
+
+void Mmc1Mapper::Reset() {
+    m_shift = 0;
+    m_shift_count = 0;
+    m_control = 0x0C;
+    m_prg_bank = 0;
+    UpdatePrg();
+}
+
+void Mmc1Mapper::Write(Word addr, Byte data) {
+    if (data & 0x80) {
+        m_shift = 0;
+        m_shift_count = 0;
+        m_control |= 0x0C;
+        UpdatePrg();
+        return;
+    }
+    m_shift |= (data & 1) << m_shift_count;
+    if (++m_shift_count < 5) {
+        return;
+    }
+    // the fifth write picks the register from address bits 13-14
+    switch ((addr >> 13) & 3) {
+        case 0: m_control = m_shift; break;
+        case 3: m_prg_bank = m_shift & 0x0F; break;
+        default: break;     // CHR banks
+    }
+    m_shift = 0;
+    m_shift_count = 0;
+    UpdatePrg();
+}
+
+void Mmc1Mapper::UpdatePrg() {
+    switch ((m_control >> 2) & 3) {
+        case 0:
+        case 1:
+            MapPrg(0x8000, 0x8000, m_prg_bank >> 1);
+            break;
+        case 2:
+            MapPrg(0x8000, 0x4000, 0);
+            MapPrg(0xC000, 0x4000, m_prg_bank);
+            break;
+        case 3:
+            MapPrg(0x8000, 0x4000, m_prg_bank);
+            MapPrg(0xC000, 0x4000, LastBank(0x4000));
+            break;
+    }
+}
+
+void UxromMapper::Reset() {
+    MapPrg(0x8000, 0x4000, 0);
+    MapPrg(0xC000, 0x4000, LastBank(0x4000));
+}
+
+void UxromMapper::Write(Word, Byte data) {
+    MapPrg(0x8000, 0x4000, data);
+}
+
+void AxromMapper::Reset() {
+    MapPrg(prg_window, prg_window_size, 0);
+}
+
+void AxromMapper::Write(Word, Byte data) {
+    MapPrg(prg_window, prg_window_size, data & 0x07);
+}
+
+void GxromMapper::Reset() {
+    MapPrg(prg_window, prg_window_size, 0);
+}
+
+void GxromMapper::Write(Word, Byte data) {
+    MapPrg(prg_window, prg_window_size, (data >> 4) & 0x03);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "types.h"
+#include "mem.h"
+
+/*  Bank switching cartridge hardware, for PRG ROM images larger than the
+    32 KB window the CPU sees at $8000-$FFFF.
+
+    Attach maps the ROM into a Mem with Mem::MapBank and makes the mapper
+    the target of every write to $8000-$FFFF, which it takes as writes to
+    its registers. A bank switch only repoints the pages of the window in
+    Mem's page table; ROM bytes are never copied. RAM below $8000 is left
+    to the caller.
+
+    The ROM is copied in and mirrored up to a power of two of at least
+    32 KB, as unconnected address lines would. A fork of the Mem (see
+    Mem::ForkFrom) gets a copy of the mapper in its current banks, sharing
+    the ROM, so either side can switch banks without the other seeing it. Bank numbers wrap at the ROM
+    size. Only the CPU side is emulated: CHR banks and mirroring control
+    bits are ignored.
+*/
+class Mapper : public MemDevice {
+public:
+
+    virtual ~Mapper() = default;
+
+    Mapper& operator=(const Mapper&) = delete;
+
+    /*  Maps the power-on banks into mem, which must not outlive the
+        mapper.
+    */
+    void Attach(Mem* mem);
+
+    /*  The mapper with iNES number `number`, or null when it is not one of
+        NROM (0), MMC1 (1), UxROM (2), AxROM (7) or GxROM (66).
+    */
+    static std::unique_ptr<Mapper> Create(u32 number, const Byte* prg, size_t prg_size);
+
+    /*  The mapper and PRG ROM of an iNES file image, or null when it is not
+        one or its mapper is not supported.
+    */
+    static std::unique_ptr<Mapper> FromINes(const Byte* file, size_t size);
+
+    /*  Never called: banked pages are read straight from the ROM. */
+    Byte Read(Word) override { return 0; }
+
+    std::unique_ptr<MemDevice> Fork(Mem* mem) override;
+
+    const std::vector<Byte>& Prg() const { return *m_prg; }
+
+protected:
+
+    Mapper(const Byte* prg, size_t prg_size);
+    // only for Clone
+    Mapper(const Mapper&) = default;
+
+    /*  A copy in the same state, attached to nothing yet. */
+    virtual std::unique_ptr<Mapper> Clone() const = 0;
+
+    /*  Maps the banks the mapper starts in. */
+    virtual void Reset() = 0;
+
+    /*  Maps bank number `bank`, counted in units of size bytes, at addr. */
+    void MapPrg(Word addr, size_t size, size_t bank);
+    size_t LastBank(size_t size) const { return m_prg->size() / size - 1; }
+
+    Mem* m_mem;
+    // shared with copies made by Fork, whose Mem maps the same banks
+    std::shared_ptr<const std::vector<Byte>> m_prg;
+};
+
+/*  Mapper 0: 16 or 32 KB of ROM and no registers. */
+class NromMapper : public Mapper {
+public:
+    NromMapper(const Byte* prg, size_t prg_size) : Mapper(prg, prg_size) {}
+    void Write(Word, Byte) override {}
+protected:
+    void Reset() override;
+    std::unique_ptr<Mapper> Clone() const override {
+        return std::unique_ptr<Mapper>(new NromMapper(*this));
+    }
+};
+
+/*  Mapper 1: five serial writes load one of four registers. PRG banks are
+    32 KB, or 16 KB with either the first or the last bank fixed.
+*/
+class Mmc1Mapper : public Mapper {
+public:
+    Mmc1Mapper(const Byte* prg, size_t prg_size) : Mapper(prg, prg_size) {}
+    void Write(Word addr, Byte data) override;
+protected:
+    void Reset() override;
+    std::unique_ptr<Mapper> Clone() const override {
+        return std::unique_ptr<Mapper>(new Mmc1Mapper(*this));
+    }
+private:
+    void UpdatePrg();
+    Byte m_shift;
+    Byte m_shift_count;
+    Byte m_control;
+    Byte m_prg_bank;
+};
+
+/*  Mapper 2: a 16 KB bank at $8000 picked by any write, the last bank
+    fixed at $C000.
+*/
+class UxromMapper : public Mapper {
+public:
+    UxromMapper(const Byte* prg, size_t prg_size) : Mapper(prg, prg_size) {}
+    void Write(Word addr, Byte data) override;
+protected:
+    void Reset() override;
+    std::unique_ptr<Mapper> Clone() const override {
+        return std::unique_ptr<Mapper>(new UxromMapper(*this));
+    }
+};
+
+/*  Mapper 7: a 32 KB bank picked by bits 0-2 of any write. */
+class AxromMapper : public Mapper {
+public:
+    AxromMapper(const Byte* prg, size_t prg_size) : Mapper(prg, prg_size) {}
+    void Write(Word addr, Byte data) override;
+protected:
+    void Reset() override;
+    std::unique_ptr<Mapper> Clone() const override {
+        return std::unique_ptr<Mapper>(new AxromMapper(*this));
+    }
+};
+
+/*  Mapper 66: a 32 KB bank picked by bits 4-5 of any write. */
+class GxromMapper : public Mapper {
+public:
+    GxromMapper(const Byte* prg, size_t prg_size) : Mapper(prg, prg_size) {}
+    void Write(Word addr, Byte data) override;
+protected:
+    void Reset() override;
+    std::unique_ptr<Mapper> Clone() const override {
+        return std::unique_ptr<Mapper>(new GxromMapper(*this));
+    }
+};
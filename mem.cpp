@@ -1,91 +1,630 @@
 #include "mem.h"
+#include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
-Mem::Mem() : m_data(nullptr), m_log_enabled(false) {
+#if defined(__linux__) || defined(__APPLE__)
+#define MEM_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
+// what untouched pages of a sparse Mem read
+static const Byte zero_page[Mem::page_size] = {};
+
+/*  A private page of a Mem without a backing store, shared with its forks
+    until one of them writes to it.
+*/
+struct MemPage {
+    std::atomic<u32> refs;
+    Byte data[Mem::page_size];
+};
+
+static void DropPage(MemPage* page) {
+    if (page->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete page;
+    }
+}
+
+MemImage::MemImage(const Byte* data, size_t num_bytes, size_t offset) :
+    m_data()
+{
+    if (offset < Mem::max_mem_size) {
+        size_t count = num_bytes < Mem::max_mem_size - offset ? num_bytes : Mem::max_mem_size - offset;
+        memcpy(m_data + offset, data, count);
+    }
+}
+
+MemArena::~MemArena() {
+    for (Byte* buffer : m_free) {
+        delete[] buffer;
+    }
+}
+
+Byte* MemArena::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free.empty()) {
+            Byte* buffer = m_free.back();
+            m_free.pop_back();
+            return buffer;
+        }
+        ++allocated;
+    }
+    return new Byte[Mem::max_mem_size];
+}
+
+void MemArena::Release(Byte* buffer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(buffer);
+}
+
+Mem::Mem(MemArena* arena) :
+    trace(nullptr),
+    m_data(nullptr),
+    m_mapped(false),
+    m_buffer(nullptr),
+    m_arena(arena),
+    m_sparse(false),
+    m_private(),
+    m_private_count(0),
+    m_devices(nullptr),
+    m_banks(nullptr),
+    m_snapshot(nullptr),
+    m_dirty(),
+    m_dirty_count(0),
+    m_opened_count(0),
+    m_watcher(nullptr),
+    m_watched(nullptr),
+    m_watched_pages(),
+    m_watched_targets()
+{
+    MapRAM(0, page_count);
 }
 
 Mem::~Mem() {
-    Unload();
+    Release();
+    if (m_arena) {
+        if (m_buffer) {
+            m_arena->Release(m_buffer);
+        }
+    } else {
+        delete[] m_buffer;
+    }
+    delete[] m_watched;
+    delete[] m_devices;
+    delete[] m_banks;
+}
+
+void Mem::UseBuffer() {
+    if (!m_buffer) {
+        m_buffer = m_arena ? m_arena->Acquire() : new Byte[max_mem_size];
+    }
+    m_data = m_buffer;
+}
+
+void Mem::MapRAM(Byte first, size_t count) {
+    for (size_t page = first; page < first + count && page < page_count; ++page) {
+        SetPage(page, PAGE_RAM, page, nullptr);
+    }
+    UpdatePages();
+    Remapped(first, count);
+}
+
+void Mem::MapROM(Byte first, size_t count) {
+    for (size_t page = first; page < first + count && page < page_count; ++page) {
+        SetPage(page, PAGE_ROM, page, nullptr);
+    }
+    UpdatePages();
+    Remapped(first, count);
+}
+
+void Mem::MapMirror(Byte first, size_t count, Byte target) {
+    for (size_t i = 0; i < count && first + i < page_count; ++i) {
+        Byte source = target + i;
+        Page t = m_pages[source];
+        SetPage(first + i, t.kind, t.target, m_devices ? m_devices[source] : nullptr,
+            t.kind == PAGE_BANK ? m_banks[source] : nullptr);
+    }
+    UpdatePages();
+    Remapped(first, count);
+}
+
+void Mem::MapIO(Byte first, size_t count, MemDevice* device) {
+    for (size_t page = first; page < first + count && page < page_count; ++page) {
+        SetPage(page, PAGE_IO, 0, device);
+    }
+    UpdatePages();
+    Remapped(first, count);
+}
+
+void Mem::MapBank(Byte first, size_t count, const Byte* data, MemDevice* writes) {
+    // Called on every bank switch, so rather than going through SetPage
+    // and UpdatePages this only stores the new pointers for its own pages.
+    if (!m_banks) {
+        m_banks = new const Byte*[page_count]();
+    }
+    if (writes && !m_devices) {
+        m_devices = new MemDevice*[page_count]();
+    }
+    size_t end = first + count < page_count ? first + count : page_count;
+    for (size_t page = first; page < end; ++page, data += page_size) {
+        Page& p = m_pages[page];
+        if (p.kind == PAGE_RAM && p.target == page) {
+            --m_plain_ram;
+        }
+        p.kind = PAGE_BANK;
+        p.target = page;
+        if (m_devices) {
+            m_devices[page] = writes;
+        }
+        m_banks[page] = data;
+        m_read[page] = data;
+        m_write[page] = nullptr;
+    }
+    Remapped(first, count);
+}
+
+void Mem::SetPage(Byte page, PageKind kind, Byte target, MemDevice* device, const Byte* bank) {
+    m_pages[page].kind = kind;
+    m_pages[page].target = target;
+    if (device && !m_devices) {
+        m_devices = new MemDevice*[page_count]();
+    }
+    if (m_devices) {
+        m_devices[page] = device;
+    }
+    if (bank && !m_banks) {
+        m_banks = new const Byte*[page_count]();
+    }
+    if (m_banks) {
+        m_banks[page] = bank;
+    }
+}
+
+void Mem::Remapped(Byte first, size_t count) {
+    if (m_watcher && count) {
+        m_watcher->OnRemap(first, first + count < page_count ? count : page_count - first);
+    }
+}
+
+void Mem::UpdatePages() {
+    memset(m_watched_targets, 0, sizeof(m_watched_targets));
+    for (size_t page = 0; page < page_count; ++page) {
+        const Page& p = m_pages[page];
+        if (m_watched_pages[page] && (p.kind == PAGE_RAM || p.kind == PAGE_ROM)) {
+            m_watched_targets[p.target] = 1;
+        }
+    }
+    m_plain_ram = 0;
+    for (size_t page = 0; page < page_count; ++page) {
+        UpdatePage(page);
+        if (m_pages[page].kind == PAGE_RAM && m_pages[page].target == page) {
+            ++m_plain_ram;
+        }
+    }
+}
+
+void Mem::UpdateTarget(Byte target) {
+    for (size_t page = 0; page < page_count; ++page) {
+        const Page& p = m_pages[page];
+        if (p.target == target && (p.kind == PAGE_RAM || p.kind == PAGE_ROM)) {
+            UpdatePage(page);
+        }
+    }
+}
+
+void Mem::UpdatePage(Byte page) {
+    const Page& p = m_pages[page];
+    const Byte* read = nullptr;
+    Byte* write = nullptr;
+    if (p.kind == PAGE_BANK) {
+        read = m_banks[page];
+    } else if (p.kind != PAGE_IO) {
+        if (m_data) {
+            read = write = m_data + p.target * page_size;
+        } else if (m_image || m_sparse) {
+            const MemPage* own = m_private[p.target];
+            read = own ? own->data : m_image ? m_image->Page(p.target) : zero_page;
+            // a page shared with a fork is copied by its first write
+            write = own && own->refs.load(std::memory_order_acquire) == 1 ? m_private[p.target]->data : nullptr;
+        }
+    }
+    m_read[page] = read;
+    bool tracked = !m_snapshot || m_dirty[p.target];
+    m_write[page] = p.kind == PAGE_RAM && !m_watched_targets[p.target] && tracked ? write : nullptr;
+}
+
+Byte* Mem::WritablePage(Byte page) {
+    if (m_data) {
+        return m_data + page * page_size;
+    }
+    if (!m_image && !m_sparse) {
+        return nullptr;
+    }
+    MemPage* own = m_private[page];
+    if (!own || own->refs.load(std::memory_order_acquire) != 1) {
+        PrivatePage(page);
+        // every page mapped to this one now reads the copy
+        UpdateTarget(page);
+    } else {
+        // the forks it was shared with may have let go of it since
+        UpdatePage(page);
+    }
+    return m_private[page]->data;
+}
+
+Byte* Mem::PrivatePage(Byte page) {
+    MemPage* own = m_private[page];
+    if (!own || own->refs.load(std::memory_order_acquire) != 1) {
+        MemPage* copy = new MemPage;
+        copy->refs.store(1, std::memory_order_relaxed);
+        memcpy(copy->data, own ? own->data : m_image ? m_image->Page(page) : zero_page, page_size);
+        if (own) {
+            DropPage(own);
+        } else {
+            ++m_private_count;
+        }
+        m_private[page] = copy;
+    }
+    return m_private[page]->data;
+}
+
+void Mem::ShareData() {
+    auto image = std::make_shared<const MemImage>(m_data, max_mem_size);
+    Release();
+    m_image = std::move(image);
+    UpdatePages();
+}
+
+void Mem::ForkFrom(Mem& parent) {
+    if (&parent == this) {
+        return;
+    }
+    if (parent.m_data) {
+        parent.ShareData();
+    }
+    Release();
+    m_image = parent.m_image;
+    m_sparse = parent.m_sparse;
+    for (size_t page = 0; page < page_count; ++page) {
+        if (MemPage* shared = parent.m_private[page]) {
+            shared->refs.fetch_add(1, std::memory_order_relaxed);
+            m_private[page] = shared;
+        }
+    }
+    m_private_count = parent.m_private_count;
+
+    // Nothing here or in parent has been written since the fork, so the
+    // tables are parent's with no page writable in place.
+    memcpy(m_pages, parent.m_pages, sizeof(m_pages));
+    memcpy(m_read, parent.m_read, sizeof(m_read));
+    memset(m_write, 0, sizeof(m_write));
+    memset(parent.m_write, 0, sizeof(parent.m_write));
+    m_plain_ram = parent.m_plain_ram;
+    if (parent.m_devices && !m_devices) {
+        m_devices = new MemDevice*[page_count]();
+    }
+    if (m_devices) {
+        // one copy per device however many pages it is on; the old copies
+        // go only now, as parent may be using one of them
+        std::vector<std::unique_ptr<MemDevice>> forked;
+        std::vector<std::pair<MemDevice*, MemDevice*>> copies;
+        for (size_t page = 0; page < page_count; ++page) {
+            MemDevice* device = parent.m_devices ? parent.m_devices[page] : nullptr;
+            if (device) {
+                size_t i = 0;
+                while (i < copies.size() && copies[i].first != device) {
+                    ++i;
+                }
+                if (i == copies.size()) {
+                    std::unique_ptr<MemDevice> copy = device->Fork(this);
+                    copies.emplace_back(device, copy ? copy.get() : device);
+                    if (copy) {
+                        forked.push_back(std::move(copy));
+                    }
+                }
+                device = copies[i].second;
+            }
+            m_devices[page] = device;
+        }
+        m_forked_devices.swap(forked);
+    }
+    if (parent.m_banks && !m_banks) {
+        m_banks = new const Byte*[page_count]();
+    }
+    if (m_banks) {
+        for (size_t page = 0; page < page_count; ++page) {
+            m_banks[page] = parent.m_banks ? parent.m_banks[page] : nullptr;
+        }
+    }
+}
+
+std::unique_ptr<Mem> Mem::Fork() {
+    std::unique_ptr<Mem> child(new Mem(m_arena));
+    child->ForkFrom(*this);
+    return child;
+}
+
+void Mem::Snapshot() {
+    if (!m_data) {
+        return;
+    }
+    if (!m_snapshot) {
+        m_snapshot = new Byte[max_mem_size];
+    }
+    memcpy(m_snapshot, m_data, max_mem_size);
+    ClearDirty();
+    UpdatePages();
+}
+
+void Mem::Restore() {
+    if (!m_snapshot) {
+        return;
+    }
+    for (size_t i = 0; i < m_dirty_count; ++i) {
+        RestorePage(m_dirty_pages[i]);
+    }
+    ClearDirty();
+}
+
+void Mem::DropSnapshot() {
+    ClearDirty();
+    delete[] m_snapshot;
+    m_snapshot = nullptr;
+    UpdatePages();
+}
+
+void Mem::MarkDirty(Byte page) {
+    Byte target = m_pages[page].target;
+    if (!m_dirty[target]) {
+        m_dirty[target] = 1;
+        m_dirty_pages[m_dirty_count++] = target;
+    }
+    if (!m_write[page]) {
+        UpdatePage(page);
+        if (m_write[page]) {
+            m_opened[m_opened_count++] = page;
+        }
+    }
+}
+
+void Mem::ClearDirty() {
+    for (size_t i = 0; i < m_dirty_count; ++i) {
+        m_dirty[m_dirty_pages[i]] = 0;
+    }
+    m_dirty_count = 0;
+    for (size_t i = 0; i < m_opened_count; ++i) {
+        UpdatePage(m_opened[i]);
+    }
+    m_opened_count = 0;
+}
+
+void Mem::RestorePage(Byte page) {
+    Byte* data = m_data + page * page_size;
+    const Byte* saved = m_snapshot + page * page_size;
+    if (m_watched_targets[page]) {
+        for (size_t i = 0; i < page_size; ++i) {
+            if (data[i] != saved[i]) {
+                data[i] = saved[i];
+                ReportWrite(page, i);
+            }
+        }
+    }
+    memcpy(data, saved, page_size);
+}
+
+void Mem::SetWatcher(MemWatcher* watcher) {
+    m_watcher = watcher;
+    ClearWatches();
+}
+
+void Mem::Watch(Word addr) {
+    if (!m_watcher) {
+        return;
+    }
+    if (!m_watched) {
+        m_watched = new Byte[max_mem_size]();
+    }
+    m_watched[addr] = 1;
+    Byte page = addr >> 8;
+    if (!m_watched_pages[page]) {
+        // writes to this page, and to every page backed by the same
+        // memory, now go through WriteSlow, which reports them
+        m_watched_pages[page] = 1;
+        const Page& p = m_pages[page];
+        if ((p.kind == PAGE_RAM || p.kind == PAGE_ROM) && !m_watched_targets[p.target]) {
+            m_watched_targets[p.target] = 1;
+            UpdateTarget(p.target);
+        }
+    }
+}
+
+void Mem::ClearWatches() {
+    if (m_watched) {
+        memset(m_watched, 0, max_mem_size);
+    }
+    memset(m_watched_pages, 0, sizeof(m_watched_pages));
+    UpdatePages();
+}
+
+void Mem::ReportWrite(Byte target, Byte offset) {
+    if (IsPlainRAM()) {
+        Word addr = target * page_size + offset;
+        if (m_watched[addr]) {
+            m_watcher->OnWrite(addr);
+        }
+        return;
+    }
+    for (size_t page = 0; page < page_count; ++page) {
+        const Page& p = m_pages[page];
+        Word addr = page * page_size + offset;
+        if (p.target == target && (p.kind == PAGE_RAM || p.kind == PAGE_ROM) && m_watched[addr]) {
+            m_watcher->OnWrite(addr);
+        }
+    }
 }
 
 
 void Mem::LoadFromFile(std::string path) {
-    Unload();
+    Release();
     
     std::ifstream memfile;
-    m_data = new Byte[max_mem_size];
+    UseBuffer();
     memfile.open(path, std::ios_base::binary | std::ios_base::in);
     memfile.read((char*)m_data, max_mem_size);
+    size_t read_size = memfile.gcount();
     memfile.close();
+    memset(m_data + read_size, 0, max_mem_size - read_size);
+    UpdatePages();
+}
+
+void Mem::MapFromFile(std::string path) {
+    Release();
+
+#ifdef MEM_MMAP
+    // The file is mapped copy-on-write, so pages are only read from disk
+    // (or the page cache) when touched and a write copies just that page;
+    // the file itself is never modified. A file shorter than 64 KB is
+    // mapped over zero filled anonymous memory.
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    size_t size = 0;
+    if (fd >= 0 && fstat(fd, &st) == 0) {
+        size = size_t(st.st_size) < max_mem_size ? size_t(st.st_size) : max_mem_size;
+    }
+    void* data = MAP_FAILED;
+    if (size == max_mem_size) {
+        data = mmap(nullptr, max_mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    if (data == MAP_FAILED) {
+        data = mmap(nullptr, max_mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        // Pages wholly past the end of the file would fault, so only map
+        // up to the page holding its last byte; the tail of that reads as 0.
+        if (data != MAP_FAILED && size > 0
+            && mmap(data, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            ssize_t read_size = pread(fd, data, size, 0);
+            (void)read_size;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (data != MAP_FAILED) {
+        m_data = static_cast<Byte*>(data);
+        m_mapped = true;
+        UpdatePages();
+        return;
+    }
+#endif
+
+    LoadFromFile(path);
 }
 
 void Mem::LoadFromData(const Byte* data, size_t byteCount) {
-    Unload();
-    m_data = new Byte[max_mem_size];
+    Release();
+    UseBuffer();
     auto copyCount = byteCount < max_mem_size ? byteCount : max_mem_size;
     memcpy(m_data, data, copyCount);
+    memset(m_data + copyCount, 0, max_mem_size - copyCount);
+    UpdatePages();
 }
 
 void Mem::LoadFromDataAtOffset(const Byte* data, size_t byteCount, size_t offset) {
-    Unload();
-
-    m_data = new Byte[max_mem_size];
+    Release();
+    UseBuffer();
 
     auto copyCount = (byteCount + offset) < max_mem_size ? byteCount : max_mem_size - offset;
+    memset(m_data, 0, offset);
     memcpy(m_data+offset, data, copyCount);
+    memset(m_data + offset + copyCount, 0, max_mem_size - offset - copyCount);
+    UpdatePages();
 }
 
-void Mem::Unload() {
-    if (m_data != nullptr) {
-        delete[] m_data;
-        m_data = nullptr;
-    }
+void Mem::LoadShared(std::shared_ptr<const MemImage> image) {
+    Release();
+    m_image = std::move(image);
+    UpdatePages();
 }
 
-
-Byte Mem::ReadByteInternal(Word addr) {
-    return m_data ? m_data[addr] : 0x0;
+void Mem::LoadSparse(const Byte* data, size_t byteCount, size_t offset) {
+    Release();
+    m_sparse = true;
+    size_t end = offset + byteCount < max_mem_size ? offset + byteCount : max_mem_size;
+    for (size_t addr = offset; addr < end; ) {
+        size_t count = page_size - (addr & 0xFF) < end - addr ? page_size - (addr & 0xFF) : end - addr;
+        memcpy(PrivatePage(addr >> 8) + (addr & 0xFF), data + (addr - offset), count);
+        addr += count;
+    }
+    UpdatePages();
 }
-Byte Mem::ReadByte(Word addr) {
-    Byte val = ReadByteInternal(addr);
-    
-    if (m_log_enabled) printf("read Byte (%02X) from addr: 0x%04X\n", val, addr);
-    return val;
+
+void Mem::Unload() {
+    Release();
+    UpdatePages();
 }
 
-Byte Mem::WriteByteInternal(Word addr, Byte data) {
-    if (!m_data) {
-        return 0x0;
+void Mem::Release() {
+#ifdef MEM_MMAP
+    if (m_mapped) {
+        munmap(m_data, max_mem_size);
+        m_mapped = false;
+    }
+#endif
+    // m_buffer is kept for the next load
+    m_data = nullptr;
+    for (MemPage*& page : m_private) {
+        if (page) {
+            DropPage(page);
+            page = nullptr;
+        }
+    }
+    m_private_count = 0;
+    m_image.reset();
+    m_sparse = false;
+    ClearDirty();
+    delete[] m_snapshot;
+    m_snapshot = nullptr;
+    if (m_watcher) {
+        if (m_watched) {
+            memset(m_watched, 0, max_mem_size);
+        }
+        memset(m_watched_pages, 0, sizeof(m_watched_pages));
+        memset(m_watched_targets, 0, sizeof(m_watched_targets));
+        m_watcher->OnReload();
     }
-    m_data[addr] = data;
-}
-Byte Mem::WriteByte(Word addr, Byte data) {
-    WriteByteInternal(addr, data);
-    if (m_log_enabled) printf("wrote Byte (%02X) to addr: 0x%04X\n", data, addr);
-    return data;
 }
 
-Word Mem::ReadWord(Word addr) {
-    if (!m_data) {
-        return 0x00;
+
+Byte Mem::ReadSlow(Word addr) {
+    const Page& page = m_pages[addr >> 8];
+    if (page.kind == PAGE_IO) {
+        return m_devices[addr >> 8]->Read(addr);
     }
-    Byte b1 = ReadByteInternal(addr),
-        b2 = ReadByteInternal(addr+1);
-    Word val = (b2 << 8) | b1;
-    if (m_log_enabled) printf("read Word (%04X) from addr: 0x%04X\n", val, addr);
-    return val;
+    return 0x0;
 }
 
-Word Mem::WriteWord(Word addr, Word data) {
-    if (!m_data) {
-        return 0x0;
+Byte Mem::WriteSlow(Word addr, Byte data) {
+    const Page& page = m_pages[addr >> 8];
+    if (page.kind == PAGE_IO || page.kind == PAGE_BANK) {
+        if (MemDevice* device = m_devices ? m_devices[addr >> 8] : nullptr) {
+            device->Write(addr, data);
+        }
+        return data;
+    }
+    Byte* host = page.kind == PAGE_RAM ? WritablePage(page.target) : nullptr;
+    if (!host) {
+        return data;
+    }
+    host[addr & 0xFF] = data;
+    if (m_snapshot) {
+        MarkDirty(addr >> 8);
+    }
+    if (m_watched_targets[page.target]) {
+        ReportWrite(page.target, addr & 0xFF);
     }
-    Byte low(data & 0xFF), high((data >> 8) & 0xFF);
-    WriteByteInternal(addr, low);
-    WriteByteInternal(addr+1, high);
-    
-    if (m_log_enabled) printf("wrote Word (%04X) to addr: 0x%04X\n", data, addr);
     return data;
 }
@@ -1,29 +1,383 @@
 #pragma once
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "types.h"
+#include "mem_trace.h"
 
+/*  Notified by Mem when a watched byte is written (see Mem::Watch), when
+    pages are mapped anew or when the whole memory is reloaded. Used to
+    keep caches of decoded code in sync with memory.
+*/
+class MemWatcher {
+public:
+    virtual ~MemWatcher() = default;
+    virtual void OnWrite(Word addr) = 0;
+    virtual void OnReload() = 0;
+    /*  Pages first to first + count - 1 were just mapped by one of the
+        Mem::Map calls, so everything they read may have changed. Their
+        watches are kept. Treated as a reload unless overridden.
+    */
+    virtual void OnRemap(Byte first, size_t count) {
+        (void)first;
+        (void)count;
+        OnReload();
+    }
+};
+
+class Mem;
+
+/*  Handles every read and write to the pages it is mapped to with
+    Mem::MapIO. addr is the full CPU address.
+*/
+class MemDevice {
+public:
+    virtual ~MemDevice() = default;
+    virtual Byte Read(Word addr) = 0;
+    virtual void Write(Word addr, Byte data) = 0;
+    /*  The device mem, a fork of the Mem this one is mapped into (see
+        Mem::ForkFrom), maps in its place: a copy of its current state
+        acting on mem, which mem then owns. Null, the default, shares this
+        device with the fork.
+    */
+    virtual std::unique_ptr<MemDevice> Fork(Mem* mem) {
+        (void)mem;
+        return nullptr;
+    }
+};
+
+/*  Pool of 64 KB backing stores shared by any number of Mem instances, so
+    creating and destroying Mems does not go through the allocator each
+    time. Safe to use from several threads. Every buffer must have been
+    released (every Mem using the arena destroyed) before the arena is.
+*/
+class MemArena {
+public:
+
+    MemArena() : allocated(0) {}
+    ~MemArena();
+
+    MemArena(const MemArena&) = delete;
+    MemArena& operator=(const MemArena&) = delete;
+
+    /*  A free buffer, or a new one if there is none. Its contents are
+        whatever the last user left in it.
+    */
+    Byte* Acquire();
+    void Release(Byte* buffer);
+
+    size_t allocated;   // buffers allocated over the arena's lifetime
+
+private:
+    std::mutex m_mutex;
+    std::vector<Byte*> m_free;
+};
+
+class MemImage;
+struct MemPage;
+
+/*  64 KB address space split into 256 pages of 256 bytes. Every page is
+    RAM backed by the same page of m_data until it is mapped otherwise, so
+    m_data holds the RAM and ROM contents at their own addresses. Memory
+    loaded with LoadShared or LoadSparse has no m_data and keeps its pages
+    separately instead.
+
+    Reads and writes look the page up in a table of host pointers and touch
+    the byte directly. Only pages without a pointer (I/O pages, writes to
+    ROM, pages with watched bytes, or no data loaded) call out to
+    ReadSlow/WriteSlow. Mappings are kept when memory is reloaded.
+*/
 class Mem {
 public:
 
     static constexpr size_t max_mem_size = 0x10000;
+    static constexpr size_t page_size = 0x100;
+    static constexpr size_t page_count = max_mem_size / page_size;
 
-    Mem();
+    /*  The backing store comes from arena when one is given. It is kept
+        across Unload and reused by the next load, and goes back to the
+        arena (or is freed) when the Mem is destroyed.
+    */
+    explicit Mem(MemArena* arena = nullptr);
     ~Mem();
 
+    Mem(const Mem&) = delete;
+    Mem& operator=(const Mem&) = delete;
+
     void LoadFromFile(std::string path);
+    /*  Like LoadFromFile, but maps the file copy-on-write where mmap is
+        available. Only pages that are touched are read in, untouched pages
+        are shared with every other Mem mapping the same file, and writes
+        never reach the file. Memory past the end of the file reads as
+        zero. Each load costs a few system calls, so for a single small
+        ROM copying with LoadFromFile is quicker.
+    */
+    void MapFromFile(std::string path);
+    /*  The loads below copy into the kept backing store and zero whatever
+        the data does not cover.
+    */
     void LoadFromData(const Byte* data, size_t num_bytes);
     void LoadFromDataAtOffset(const Byte* data, size_t num_bytes, size_t offset);
+    /*  Reads come straight from image, which any number of Mems can share.
+        The first write to a RAM page copies that page into a private 256
+        byte page, so each Mem only holds the pages it has written. m_data
+        is null while an image is loaded; JitCPU, which needs it,
+        interprets, and Snapshot does nothing.
+    */
+    void LoadShared(std::shared_ptr<const MemImage> image);
+    /*  Like LoadShared, but over no image at all: untouched memory reads
+        as zero from one page shared by every Mem, and a private page is
+        only allocated on the first write to it (or here, for the pages
+        data covers). For very many instances that each touch a few pages.
+    */
+    void LoadSparse(const Byte* data = nullptr, size_t num_bytes = 0, size_t offset = 0);
+    /*  Loads the current contents and mappings of parent without copying
+        any memory. The two share parent's image and every page parent has
+        written, and whichever writes a shared page first takes a private
+        copy of just that page, so forking costs the same however much
+        memory there is and each side pays only for the pages it writes.
+        Forks can be forked again, and parent and forks can be run and
+        destroyed on different threads in any order, but parent must not
+        be in use while it is forked. Each device gets the copy its
+        MemDevice::Fork makes, so a mapper's bank switches in the fork only
+        remap the fork; devices that make none are shared. Watches,
+        snapshots and traces are not carried over.
+
+        A Mem with its own backing store (LoadFromData, LoadFromFile,
+        MapFromFile) is first moved onto a MemImage of its contents, which
+        copies 64 KB once and drops its snapshot.
+    */
+    void ForkFrom(Mem& parent);
+    /*  A new Mem loaded with ForkFrom(*this), on the same arena. Destroying
+        it, or loading over it, only drops its own pages.
+    */
+    std::unique_ptr<Mem> Fork();
     void Unload();
 
-    Byte ReadByte(Word addr);
-    Byte WriteByte(Word addr, Byte data);
-    Word ReadWord(Word addr);
-    Word WriteWord(Word addr, Word data);
+    /*  Inline, and forced to be, so that a hit in the page table is a
+        load of the page pointer and the access itself wherever they are
+        called (see bench/mem.cpp).
+    */
+    [[gnu::always_inline]] Byte ReadByte(Word addr);
+    [[gnu::always_inline]] Byte WriteByte(Word addr, Byte data);
+    [[gnu::always_inline]] Word ReadWord(Word addr);
+    [[gnu::always_inline]] Word WriteWord(Word addr, Word data);
+
+    /*  Page mapping. Each call maps count pages starting at page first. */
+    void MapRAM(Byte first, size_t count);
+    /*  Reads come from m_data, writes are ignored. */
+    void MapROM(Byte first, size_t count);
+    /*  Page first + i takes the mapping page target + i has at the time of
+        the call, so it reads and writes the same bytes or device.
+    */
+    void MapMirror(Byte first, size_t count, Byte target);
+    /*  Reads and writes go to device, which is owned by the caller. */
+    void MapIO(Byte first, size_t count, MemDevice* device);
+    /*  Reads come from data, count pages of it owned by the caller and
+        usually a window into a ROM image larger than 64 KB. Writes go to
+        writes when set (a mapper's registers, see mapper.h) and are
+        ignored otherwise. Only touches the given pages, so a mapper can
+        switch banks with it as often as it likes.
+    */
+    void MapBank(Byte first, size_t count, const Byte* data, MemDevice* writes = nullptr);
+
+    /*  True when every page is plain RAM at its own address, so m_data can
+        be read and written directly without changing behaviour.
+    */
+    bool IsPlainRAM() const { return m_plain_ram == page_count; }
+
+    /*  Host pointer for reading or writing all of page, or null while its
+        accesses have to go through ReadByte and WriteByte: an I/O page,
+        writes to ROM, watched bytes, the first write to a page after
+        Snapshot or to a shared page, or while tracing. Any access through
+        Mem may change it, so it is only good until the next one.
+    */
+    const Byte* ReadPage(Byte page) const { return trace_enabled && trace ? nullptr : m_read[page]; }
+    Byte* WritePage(Byte page) const { return trace_enabled && trace ? nullptr : m_write[page]; }
+
+    /*  Saves the current memory contents. From then on every page written
+        through WriteByte or WriteWord is marked dirty, and Restore copies
+        back just the dirty pages, so resetting after a run costs in
+        proportion to the memory it touched. Only the first write to each
+        page after Snapshot or Restore leaves the fast path. The snapshot
+        is kept until DropSnapshot or the next load. Mappings are not part
+        of it, and watchers are told about restored bytes they watch.
+    */
+    void Snapshot();
+    void Restore();
+    void DropSnapshot();
+    bool HasSnapshot() const { return m_snapshot != nullptr; }
+    /*  page is a page of m_data, which for a mirror is its target. */
+    bool IsDirty(Byte page) const { return m_dirty[page] != 0; }
+    size_t DirtyPageCount() const { return m_dirty_count; }
+
+    /*  Pages copied out of a shared image by writes (see LoadShared),
+        including those still shared with forks (see ForkFrom).
+    */
+    size_t PrivatePageCount() const { return m_private_count; }
+
+    /*  Only one watcher at a time. Setting a new one clears all watches.
+        A write is reported at every watched address that reads the byte
+        written, so a write through a mirror of a watched byte is reported
+        at the watched address.
+    */
+    void SetWatcher(MemWatcher* watcher);
+    void Watch(Word addr);
+
+    /*  Accesses through ReadByte, WriteByte, ReadWord and WriteWord are
+        recorded into trace when it is set, but only in builds with
+        MEM_TRACE defined. Other builds have no check for it at all.
+    */
+#ifdef MEM_TRACE
+    static constexpr bool trace_enabled = true;
+#else
+    static constexpr bool trace_enabled = false;
+#endif
+    MemTrace* trace;
 
-    bool m_log_enabled;
     Byte* m_data;
 private:
-    
-    Byte ReadByteInternal(Word addr);
-    Byte WriteByteInternal(Word addr, Byte data);
+
+    bool m_mapped;      // m_data was mapped from a file by MapFromFile
+    Byte* m_buffer;     // backing store, kept across loads
+    MemArena* m_arena;
+
+    std::shared_ptr<const MemImage> m_image;
+    bool m_sparse;      // loaded with LoadSparse
+    /*  Pages of m_image this Mem has written, reference counted so forks
+        can share them. Only written in place while this Mem is the one
+        holding it.
+    */
+    MemPage* m_private[page_count];
+    size_t m_private_count;
+    /*  Where writes to page of m_data (or of m_image) go, making a private
+        copy of a shared page first. Null when nothing is loaded.
+    */
+    Byte* WritablePage(Byte page);
+    /*  The private copy of page, made without updating the page table. */
+    Byte* PrivatePage(Byte page);
+    /*  Moves m_data onto a MemImage of it, for ForkFrom. */
+    void ShareData();
+
+    /*  Points m_data at the backing store, allocating it on first use. */
+    void UseBuffer();
+    /*  Unload without updating the page table, for loads that update it
+        once they are done.
+    */
+    void Release();
+
+    enum PageKind : Byte { PAGE_RAM, PAGE_ROM, PAGE_IO, PAGE_BANK };
+
+    struct Page {
+        PageKind kind;
+        Byte target;        // page of m_data behind a RAM or ROM page
+    };
+
+    /*  Host pointer to the start of each page, or null when the access has
+        to go through ReadSlow/WriteSlow.
+    */
+    const Byte* m_read[page_count];
+    Byte* m_write[page_count];
+    Page m_pages[page_count];
+    MemDevice** m_devices;  // for PAGE_IO and PAGE_BANK, allocated on first use
+    const Byte** m_banks;   // for PAGE_BANK, allocated by the first MapBank
+    // the copies of parent's devices the last ForkFrom made
+    std::vector<std::unique_ptr<MemDevice>> m_forked_devices;
+    size_t m_plain_ram;     // pages that are RAM at their own address
+
+    /*  Dirty tracking for Snapshot. A clean RAM page has no m_write pointer,
+        so its first write goes to WriteSlow, which marks it dirty and
+        gives the page its pointer back. m_opened lists the pages given one
+        so Restore can take them away without walking the whole table.
+    */
+    Byte* m_snapshot;
+    Byte m_dirty[page_count];
+    Byte m_dirty_pages[page_count];
+    size_t m_dirty_count;
+    Byte m_opened[page_count];
+    size_t m_opened_count;
+    void MarkDirty(Byte page);
+    void ClearDirty();
+    void RestorePage(Byte page);
+
+    MemWatcher* m_watcher;
+    Byte* m_watched;    // one flag per address, allocated on first Watch
+    Byte m_watched_pages[page_count];
+    /*  Pages of m_data that a RAM or ROM page with watched bytes reads,
+        so writes through every page backed by them go through WriteSlow.
+    */
+    Byte m_watched_targets[page_count];
+    void ClearWatches();
+    /*  Reports a write to byte offset of page target of m_data at every
+        watched address backed by it.
+    */
+    void ReportWrite(Byte target, Byte offset);
+
+    void SetPage(Byte page, PageKind kind, Byte target, MemDevice* device, const Byte* bank = nullptr);
+    /*  Tells the watcher about a Map call. */
+    void Remapped(Byte first, size_t count);
+    void UpdatePages();
+    void UpdatePage(Byte page);
+    /*  UpdatePage for every page backed by page target of m_data. */
+    void UpdateTarget(Byte target);
+    // Kept out of line so that the inlined ReadByte and WriteByte stay
+    // small at every call site.
+    [[gnu::noinline]] Byte ReadSlow(Word addr);
+    [[gnu::noinline]] Byte WriteSlow(Word addr, Byte data);
+
+    [[gnu::always_inline]] Byte ReadByteInternal(Word addr) {
+        const Byte* page = m_read[addr >> 8];
+        return page ? page[addr & 0xFF] : ReadSlow(addr);
+    }
+    [[gnu::always_inline]] Byte WriteByteInternal(Word addr, Byte data) {
+        Byte* page = m_write[addr >> 8];
+        if (!page) {
+            return WriteSlow(addr, data);
+        }
+        return page[addr & 0xFF] = data;
+    }
+};
+
+inline Byte Mem::ReadByte(Word addr) {
+    Byte val = ReadByteInternal(addr);
+    if (trace_enabled && trace) trace->Record(addr, val, MEM_READ_BYTE);
+    return val;
+}
+
+inline Byte Mem::WriteByte(Word addr, Byte data) {
+    WriteByteInternal(addr, data);
+    if (trace_enabled && trace) trace->Record(addr, data, MEM_WRITE_BYTE);
+    return data;
+}
+
+inline Word Mem::ReadWord(Word addr) {
+    Byte b1 = ReadByteInternal(addr),
+        b2 = ReadByteInternal(addr+1);
+    Word val = (b2 << 8) | b1;
+    if (trace_enabled && trace) trace->Record(addr, val, MEM_READ_WORD);
+    return val;
+}
+
+inline Word Mem::WriteWord(Word addr, Word data) {
+    Byte low(data & 0xFF), high((data >> 8) & 0xFF);
+    WriteByteInternal(addr, low);
+    WriteByteInternal(addr+1, high);
+    if (trace_enabled && trace) trace->Record(addr, data, MEM_WRITE_WORD);
+    return data;
+}
+
+/*  Read-only 64 KB memory image for Mem::LoadShared. Shared by holding it
+    in a std::shared_ptr, which frees it once the last Mem using it is
+    unloaded. Bytes the data does not cover are zero.
+*/
+class MemImage {
+public:
+
+    MemImage(const Byte* data, size_t num_bytes, size_t offset = 0);
+
+    const Byte* Page(Byte page) const { return m_data + page * Mem::page_size; }
+
+private:
+    Byte m_data[Mem::max_mem_size];
 };
@@ -0,0 +1,61 @@
+#include "mem_trace.h"
+#include <chrono>
+
+MemTrace::MemTrace(Sink sink, size_t capacity) :
+    dropped(0),
+    m_sink(std::move(sink)),
+    m_head(0),
+    m_tail(0),
+    m_stop(false)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    m_ring.reset(new MemAccess[size]);
+    m_mask = size - 1;
+    m_thread = std::thread(&MemTrace::Drain, this);
+}
+
+MemTrace::~MemTrace() {
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+}
+
+MemTrace::Sink MemTrace::ToFile(FILE* file) {
+    return [file](const MemAccess* accesses, size_t count) {
+        fwrite(accesses, sizeof(MemAccess), count, file);
+    };
+}
+
+void MemTrace::Flush() {
+    u64 head = m_head.load(std::memory_order_relaxed);
+    while (m_tail.load(std::memory_order_acquire) < head) {
+        std::this_thread::yield();
+    }
+}
+
+void MemTrace::Drain() {
+    for (;;) {
+        // Read m_stop first so the last batch includes everything recorded
+        // before the destructor ran.
+        bool stop = m_stop.load(std::memory_order_acquire);
+        u64 tail = m_tail.load(std::memory_order_relaxed);
+        u64 head = m_head.load(std::memory_order_acquire);
+        if (head == tail) {
+            if (stop) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        // Hand over up to the end of the ring, the rest goes next time round.
+        u64 start = tail & m_mask;
+        u64 count = head - tail;
+        if (start + count > m_mask + 1) {
+            count = m_mask + 1 - start;
+        }
+        m_sink(&m_ring[start], count);
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+}
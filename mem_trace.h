@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "types.h"
+
+enum MemAccessKind : Byte {
+    MEM_READ_BYTE,
+    MEM_WRITE_BYTE,
+    MEM_READ_WORD,
+    MEM_WRITE_WORD,
+};
+
+/*  One traced access, stored as is in the ring and handed to the sink. */
+struct MemAccess {
+    Word addr;
+    Word value;
+    MemAccessKind kind;
+};
+
+/*  Trace of memory accesses for builds with MEM_TRACE defined (see
+    Mem::trace). Accesses are appended to a preallocated ring buffer and a
+    thread owned by the trace drains them in batches into the sink, so the
+    emulating thread only stores a few bytes per access. Only one thread
+    may record. When the ring is full, accesses are dropped and counted
+    rather than stalling the emulator.
+*/
+class MemTrace {
+public:
+
+    /*  Called on the drain thread with each batch of accesses, in order. */
+    typedef std::function<void(const MemAccess* accesses, size_t count)> Sink;
+
+    /*  capacity is rounded up to a power of two. */
+    explicit MemTrace(Sink sink, size_t capacity = 0x10000);
+    /*  Drains whatever is left into the sink before returning. */
+    ~MemTrace();
+
+    MemTrace(const MemTrace&) = delete;
+    MemTrace& operator=(const MemTrace&) = delete;
+
+    /*  Sink writing the raw MemAccess records to file, which stays owned
+        by the caller.
+    */
+    static Sink ToFile(FILE* file);
+
+    void Record(Word addr, Word value, MemAccessKind kind) {
+        u64 head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            ++dropped;
+            return;
+        }
+        m_ring[head & m_mask] = MemAccess{addr, value, kind};
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /*  Blocks until everything recorded so far has reached the sink. */
+    void Flush();
+
+    u64 dropped;    // accesses lost because the ring was full
+
+private:
+
+    void Drain();
+
+    Sink m_sink;
+    std::unique_ptr<MemAccess[]> m_ring;
+    u64 m_mask;
+    std::atomic<u64> m_head;    // next slot to record into
+    std::atomic<u64> m_tail;    // next slot to hand to the sink
+    std::atomic<bool> m_stop;
+    std::thread m_thread;
+};
@@ -0,0 +1,356 @@
+#pragma once
+#include <array>
+#include "types.h"
+
+/* LDA */
+static constexpr Byte INS_LDA_IM = 0xA9;
+static constexpr Byte INS_LDA_ZP = 0xA5;
+static constexpr Byte INS_LDA_ZPX = 0xB5;
+static constexpr Byte INS_LDA_ABS = 0xAD;
+static constexpr Byte INS_LDA_ABSX = 0xBD;
+static constexpr Byte INS_LDA_ABSY = 0xB9;
+static constexpr Byte INS_LDA_INDX = 0xA1;
+static constexpr Byte INS_LDA_INDY = 0xB1;
+/* LDX */
+static constexpr Byte INS_LDX_IM = 0xA2;
+static constexpr Byte INS_LDX_ZP = 0xA6;
+static constexpr Byte INS_LDX_ZPY = 0xB6;
+static constexpr Byte INS_LDX_ABS = 0xAE;
+static constexpr Byte INS_LDX_ABSY = 0xBE;
+/* LDY */
+static constexpr Byte INS_LDY_IM = 0xA0;
+static constexpr Byte INS_LDY_ZP = 0xA4;
+static constexpr Byte INS_LDY_ZPX = 0xB4;
+static constexpr Byte INS_LDY_ABS = 0xAC;
+static constexpr Byte INS_LDY_ABSX = 0xBC;
+
+/* LSR
+Each of the bits in A or M is shift one place to the right.
+The bit that was in bit 0 is shifted into the carry flag.
+Bit 7 is set to zero. 
+
+For mem operations: data is loaded into accumulator, shifted, then written back to memory
+*/
+static constexpr Byte INS_LSR_A    = 0x4A;
+static constexpr Byte INS_LSR_ZP   = 0x46;
+static constexpr Byte INS_LSR_ZPX  = 0x56;
+static constexpr Byte INS_LSR_ABS  = 0x4E;
+static constexpr Byte INS_LSR_ABSX = 0x5E;
+
+/* ROR
+Each of the bits in A or M is shift one place to the right.
+Bit 7 is filled with the current value of the carry flag 
+whilst the old bit 0 becomes the new carry flag value.
+
+For mem operations: data is loaded into accumulator, shifted, then written back to memory
+*/
+static constexpr Byte INS_ROR_A    = 0x6A;
+static constexpr Byte INS_ROR_ZP   = 0x66;
+static constexpr Byte INS_ROR_ZPX  = 0x76;
+static constexpr Byte INS_ROR_ABS  = 0x6E;
+static constexpr Byte INS_ROR_ABSX = 0x7E;
+
+/* ROL
+Move each of the bits in either A or M one place to the left.
+Bit 0 is filled with the current value of the carry flag whilst
+the old bit 7 becomes the new carry flag value.
+
+For mem operations: data is loaded into accumulator, shifted, then written back to memory
+*/
+static constexpr Byte INS_ROL_A    = 0x2A;
+static constexpr Byte INS_ROL_ZP   = 0x26;
+static constexpr Byte INS_ROL_ZPX  = 0x36;
+static constexpr Byte INS_ROL_ABS  = 0x2E;
+static constexpr Byte INS_ROL_ABSX = 0x3E;
+
+/* ASL
+This operation shifts all the bits of the accumulator or
+memory contents one bit left.
+Bit 0 is set to 0 and bit 7 is placed in the carry flag.
+The effect of this operation is to multiply the memory
+contents by 2 (ignoring 2's complement considerations),
+setting the carry if the result will not fit in 8 bits.
+
+For mem operations: data is loaded into accumulator, shifted, then written back to memory
+*/
+static constexpr Byte INS_ASL_A    = 0x0A;
+static constexpr Byte INS_ASL_ZP   = 0x06;
+static constexpr Byte INS_ASL_ZPX  = 0x16;
+static constexpr Byte INS_ASL_ABS  = 0x0E;
+static constexpr Byte INS_ASL_ABSX = 0x1E;
+
+/* STA */
+static constexpr Byte INS_STA_ZP   = 0x85;
+static constexpr Byte INS_STA_ZPX  = 0x95;
+static constexpr Byte INS_STA_ABS  = 0x8D;
+static constexpr Byte INS_STA_ABSX = 0x9D;
+static constexpr Byte INS_STA_ABSY = 0x99;
+static constexpr Byte INS_STA_INDX = 0x81;
+static constexpr Byte INS_STA_INDY = 0x91;
+
+/* STX */
+static constexpr Byte INS_STX_ZP   = 0x86;
+static constexpr Byte INS_STX_ZPY  = 0x96;
+static constexpr Byte INS_STX_ABS  = 0x8E;
+
+/* STY */
+static constexpr Byte INS_STY_ZP   = 0x84;
+static constexpr Byte INS_STY_ZPX  = 0x94;
+static constexpr Byte INS_STY_ABS  = 0x8C;
+
+/* Transfer between regs */
+static constexpr Byte INS_TAX  = 0xAA;
+static constexpr Byte INS_TXA  = 0x8A;
+static constexpr Byte INS_TAY  = 0xA8;
+static constexpr Byte INS_TYA  = 0x98;
+static constexpr Byte INS_TSX  = 0xBA;
+static constexpr Byte INS_TXS  = 0x9A;
+
+/* Set/Clear flags */
+static constexpr Byte INS_SEC  = 0x38;
+static constexpr Byte INS_SED  = 0xF8;
+static constexpr Byte INS_SEI  = 0x78;
+static constexpr Byte INS_CLC  = 0x18;
+static constexpr Byte INS_CLD  = 0xD8;
+static constexpr Byte INS_CLI  = 0x58;
+
+/* BIT test 
+This instructions is used to test if 
+one or more bits are set in a target memory location.
+The mask pattern in A is ANDed with the value in memory
+to set or clear the zero flag, but the result is not kept.
+Bits 7 and 6 of the value from memory are copied into the N and V flags.
+*/
+static constexpr Byte INS_BIT_ZP  = 0x24;
+static constexpr Byte INS_BIT_ABS = 0x2C;
+
+/* Branch Instructions */
+static constexpr Byte INS_BMI  = 0x30; // branch if minus (Negative is set)
+static constexpr Byte INS_BPL  = 0x10; // branch if positive (Negative is clear)
+static constexpr Byte INS_BNE  = 0xD0; // branch if not equal (Zero is clear)
+static constexpr Byte INS_BEQ  = 0xF0; // branch if positive (Zero is set)
+static constexpr Byte INS_BCC  = 0x90; // branch if not equal (Carry is clear)
+static constexpr Byte INS_BCS  = 0xB0; // branch if positive (Carry is set)
+static constexpr Byte INS_BVC  = 0x50; // branch if not equal (Overflow is clear)
+static constexpr Byte INS_BVS  = 0x70; // branch if positive (Overflow is set)
+
+/* AND instructions */
+static constexpr Byte INS_AND_IM   = 0x29;
+static constexpr Byte INS_AND_ZP   = 0x25;
+static constexpr Byte INS_AND_ZPX  = 0x35;
+static constexpr Byte INS_AND_ABS  = 0x2D;
+static constexpr Byte INS_AND_ABSX = 0x3D;
+static constexpr Byte INS_AND_ABSY = 0x39;
+static constexpr Byte INS_AND_INDX = 0x21;
+static constexpr Byte INS_AND_INDY = 0x31;
+
+/* ADC - Add with carry 
+
+The more confusing thing is the overflow flag.
+It tells you if the sign of the result is wrong in signed operations,
+such that for example you added to positive numbers together,
+for example $4E and $53 which give $A1 which appears negative
+since the high bit is set. 
+
+www.6502.org/tutorials/vflag.html
+
+*/
+static constexpr Byte INS_ADC_IM   = 0x69;
+static constexpr Byte INS_ADC_ZP   = 0x65;
+static constexpr Byte INS_ADC_ZPX  = 0x75;
+static constexpr Byte INS_ADC_ABS  = 0x6D;
+static constexpr Byte INS_ADC_ABSX = 0x7D;
+static constexpr Byte INS_ADC_ABSY = 0x79;
+static constexpr Byte INS_ADC_INDX = 0x61;
+static constexpr Byte INS_ADC_INDY = 0x71;
+
+/* 65C02 only, see CPU_OPCODES_65C02 */
+static constexpr Byte INS_BRA      = 0x80; // branch always
+static constexpr Byte INS_LDA_ZPI  = 0xB2;
+static constexpr Byte INS_STA_ZPI  = 0x92;
+static constexpr Byte INS_AND_ZPI  = 0x32;
+static constexpr Byte INS_ADC_ZPI  = 0x72;
+
+/* SBC - subtract with carry */
+static constexpr Byte INS_SBC_IM   = 0xE9;
+static constexpr Byte INS_SBC_ZP   = 0xE5;
+static constexpr Byte INS_SBC_ZPX  = 0xF5;
+static constexpr Byte INS_SBC_ABS  = 0xED;
+static constexpr Byte INS_SBC_ABSX = 0xFD;
+static constexpr Byte INS_SBC_ABSY = 0xF9;
+static constexpr Byte INS_SBC_INDX = 0xE1;
+static constexpr Byte INS_SBC_INDY = 0xF1;
+
+/* Addressing modes, used to size and decode an instruction's operand. */
+enum AddressingMode : Byte {
+    AM_IMP,     // implied, no operand
+    AM_ACC,     // accumulator, no operand
+    AM_IMM,     // #$nn
+    AM_ZP,      // $nn
+    AM_ZPX,     // $nn,X
+    AM_ZPY,     // $nn,Y
+    AM_ABS,     // $nnnn
+    AM_ABSX,    // $nnnn,X
+    AM_ABSY,    // $nnnn,Y
+    AM_INDX,    // ($nn,X)
+    AM_INDY,    // ($nn),Y
+    AM_REL,     // branch offset
+    AM_ZPI,     // ($nn), 65C02 only
+};
+
+/* Number of operand bytes that follow the opcode for each mode. */
+static constexpr Byte OperandSize(AddressingMode mode) {
+    switch (mode) {
+        case AM_IMP:
+        case AM_ACC:
+            return 0;
+        case AM_ABS:
+        case AM_ABSX:
+        case AM_ABSY:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+/* Opcodes implemented by the CPU.
+Each entry X(name, mode, cycles) refers to the INS_name constant above and
+to the CPU::Op_name handler. mode is the AddressingMode without its AM_
+prefix and cycles is the base cycle count; the handler only returns the
+cycles added on top of that by page crossings and taken branches.
+The dispatch tables are built from this list, so a new opcode only has to
+be added here and given a handler.
+*/
+#define CPU_OPCODES(X) \
+    X(LDA_IM,   IMM,  2) \
+    X(LDA_ZP,   ZP,   3) \
+    X(LDA_ZPX,  ZPX,  4) \
+    X(LDA_ABS,  ABS,  4) \
+    X(LDA_ABSX, ABSX, 4) \
+    X(LDA_ABSY, ABSY, 4) \
+    X(LDA_INDX, INDX, 6) \
+    X(LDA_INDY, INDY, 5) \
+    X(LDX_IM,   IMM,  2) \
+    X(LDX_ZP,   ZP,   3) \
+    X(LDX_ZPY,  ZPY,  4) \
+    X(LDX_ABS,  ABS,  4) \
+    X(LDX_ABSY, ABSY, 4) \
+    X(LDY_IM,   IMM,  2) \
+    X(LDY_ZP,   ZP,   3) \
+    X(LDY_ZPX,  ZPX,  4) \
+    X(LDY_ABS,  ABS,  4) \
+    X(LDY_ABSX, ABSX, 4) \
+    X(LSR_A,    ACC,  2) \
+    X(LSR_ZP,   ZP,   5) \
+    X(LSR_ZPX,  ZPX,  6) \
+    X(LSR_ABS,  ABS,  6) \
+    X(LSR_ABSX, ABSX, 7) \
+    X(ROR_A,    ACC,  2) \
+    X(ROR_ZP,   ZP,   5) \
+    X(ROR_ZPX,  ZPX,  6) \
+    X(ROR_ABS,  ABS,  6) \
+    X(ROR_ABSX, ABSX, 7) \
+    X(ROL_A,    ACC,  2) \
+    X(ROL_ZP,   ZP,   5) \
+    X(ROL_ZPX,  ZPX,  6) \
+    X(ROL_ABS,  ABS,  6) \
+    X(ROL_ABSX, ABSX, 7) \
+    X(ASL_A,    ACC,  2) \
+    X(ASL_ZP,   ZP,   5) \
+    X(ASL_ZPX,  ZPX,  6) \
+    X(ASL_ABS,  ABS,  6) \
+    X(ASL_ABSX, ABSX, 7) \
+    X(STA_ZP,   ZP,   3) \
+    X(STA_ZPX,  ZPX,  4) \
+    X(STA_ABS,  ABS,  4) \
+    X(STA_ABSX, ABSX, 5) \
+    X(STA_ABSY, ABSY, 5) \
+    X(STA_INDX, INDX, 6) \
+    X(STA_INDY, INDY, 6) \
+    X(STX_ZP,   ZP,   3) \
+    X(STX_ZPY,  ZPY,  4) \
+    X(STX_ABS,  ABS,  4) \
+    X(STY_ZP,   ZP,   3) \
+    X(STY_ZPX,  ZPX,  4) \
+    X(STY_ABS,  ABS,  4) \
+    X(TAX,      IMP,  2) \
+    X(TXA,      IMP,  2) \
+    X(TAY,      IMP,  2) \
+    X(TYA,      IMP,  2) \
+    X(TSX,      IMP,  2) \
+    X(TXS,      IMP,  2) \
+    X(SEC,      IMP,  2) \
+    X(SED,      IMP,  2) \
+    X(SEI,      IMP,  2) \
+    X(CLC,      IMP,  2) \
+    X(CLD,      IMP,  2) \
+    X(CLI,      IMP,  2) \
+    X(BIT_ZP,   ZP,   3) \
+    X(BIT_ABS,  ABS,  4) \
+    X(BMI,      REL,  2) \
+    X(BPL,      REL,  2) \
+    X(BNE,      REL,  2) \
+    X(BEQ,      REL,  2) \
+    X(BCS,      REL,  2) \
+    X(BCC,      REL,  2) \
+    X(BVC,      REL,  2) \
+    X(BVS,      REL,  2) \
+    X(AND_IM,   IMM,  2) \
+    X(AND_ZP,   ZP,   3) \
+    X(AND_ZPX,  ZPX,  4) \
+    X(AND_ABS,  ABS,  4) \
+    X(AND_ABSX, ABSX, 4) \
+    X(AND_ABSY, ABSY, 4) \
+    X(AND_INDX, INDX, 6) \
+    X(AND_INDY, INDY, 5) \
+    X(ADC_IM,   IMM,  2) \
+    X(ADC_ZP,   ZP,   3) \
+    X(ADC_ZPX,  ZPX,  4) \
+    X(ADC_ABS,  ABS,  4) \
+    X(ADC_ABSX, ABSX, 4) \
+    X(ADC_ABSY, ABSY, 4) \
+    X(ADC_INDX, INDX, 6) \
+    X(ADC_INDY, INDY, 5)
+
+/* Opcodes only the 65C02 implements (see Cmos65C02 in cpu_variant.h), in the
+same form as CPU_OPCODES.
+*/
+#define CPU_OPCODES_65C02(X) \
+    X(BRA,      REL,  2) \
+    X(LDA_ZPI,  ZPI,  5) \
+    X(STA_ZPI,  ZPI,  5) \
+    X(AND_ZPI,  ZPI,  5) \
+    X(ADC_ZPI,  ZPI,  5)
+
+struct OpcodeInfo {
+    AddressingMode mode;
+    Byte operand_size;
+    Byte cycles;        // base cycles, 0 for unknown opcodes
+    bool implemented;
+};
+
+typedef std::array<OpcodeInfo, 0x100> OpcodeTable;
+
+/*  cmos builds the 65C02 table: its extra opcodes, and 6 instead of 7 base
+    cycles for the $nnnn,X shifts and rotates.
+*/
+constexpr OpcodeTable BuildOpcodeInfo(bool cmos) {
+    OpcodeTable info{};
+#define OPCODE_INFO_ENTRY(name, mode, cycles) \
+    info[INS_##name] = OpcodeInfo{ AM_##mode, OperandSize(AM_##mode), cycles, true };
+    CPU_OPCODES(OPCODE_INFO_ENTRY)
+    if (cmos) {
+        CPU_OPCODES_65C02(OPCODE_INFO_ENTRY)
+        for (Byte opcode : {INS_LSR_ABSX, INS_ROR_ABSX, INS_ROL_ABSX, INS_ASL_ABSX}) {
+            info[opcode].cycles = 6;
+        }
+    }
+#undef OPCODE_INFO_ENTRY
+    return info;
+}
+
+/* Decoding information for all 256 opcodes, indexed by opcode. */
+inline constexpr OpcodeTable opcode_info = BuildOpcodeInfo(false);
+
+/* The same for the 65C02. */
+inline constexpr OpcodeTable opcode_info_65c02 = BuildOpcodeInfo(true);
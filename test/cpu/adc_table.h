@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+#include <adc_table.h>
+
+/*  Checks adc_table exhaustively against the arithmetic the ADC handlers
+    did before it existed: DO_ADD and SET_ADD_FLAGS, copied as they were
+    apart from the flags being plain variables.
+*/
+class AdcTable_Tests : public CxxTest::TestSuite 
+{
+public:
+
+    struct Reference {
+        Byte A;
+        Byte Carry;
+        Byte DecimalMode;
+        Byte Zero;
+        Byte Negative;
+        Byte Overflow;
+
+        void Adc(Byte v1, Byte v2) {
+            // DO_ADD
+            Byte c = Carry;
+            Carry = 0;
+            if (DecimalMode) {
+                Byte lb1 = (v1&0x0F);
+                Byte lb2 = (v2&0x0F);
+                Byte lb = lb1 + lb2 + c;
+                if (lb > 0x09) {
+                    lb += 0x06;
+                }
+                Byte hb1 = (v1&0xF0)>>4;
+                Byte hb2 = (v2&0xF0)>>4;
+                Byte hc = (lb >> 4);
+                Byte hb = hb1 + hb2 ;
+                if ((hb+ hc) > 0x09) {
+                    hb += 0x06;
+                    Carry = 1;
+                }
+                A = (hb << 4) + lb;
+            } else {
+                Word w1 = v1,w2 = v2;
+                w1 = w1+w2+c;
+                A = w1 & 0xFF;
+                Carry = (w1 & 0x0100) != 0;
+            }
+            // SET_ADD_FLAGS
+            Zero = A == 0;
+            Negative = (A & 0x80) != 0;
+            Overflow = (v1<0x80) && (v2<0x80) && ((v1+v2) >= 0x80);
+        }
+    };
+
+    void test_Table_should_match_reference( void ) {
+        u32 mismatches = 0;
+        for (u32 decimal = 0; decimal < 2; ++decimal) {
+            for (u32 carry = 0; carry < 2; ++carry) {
+                for (u32 a = 0; a < 0x100; ++a) {
+                    for (u32 v = 0; v < 0x100; ++v) {
+                        Reference ref = {Byte(a), Byte(carry), Byte(decimal), 0, 0, 0};
+                        ref.Adc(a, v);
+                        AdcResult r = adc_table[AdcIndex(a, v, carry, decimal)];
+
+                        bool same = r.result == ref.A
+                            && ((r.flags & ADC_FLAG_C) != 0) == ref.Carry
+                            && ((r.flags & ADC_FLAG_Z) != 0) == ref.Zero
+                            && ((r.flags & ADC_FLAG_V) != 0) == ref.Overflow
+                            && ((r.flags & ADC_FLAG_N) != 0) == ref.Negative;
+                        if (!same) {
+                            ++mismatches;
+                        }
+                    }
+                }
+            }
+        }
+        TS_ASSERT_EQUALS(mismatches, 0);
+    }
+
+    void test_ADC_should_match_reference( void ) {
+        // ADC #v for a sample of operands, through the handler
+        Mem mem;
+        CPU cpu(&mem);
+        for (u32 decimal = 0; decimal < 2; ++decimal) {
+            for (u32 carry = 0; carry < 2; ++carry) {
+                for (u32 a = 0; a < 0x100; a += 7) {
+                    for (u32 v = 0; v < 0x100; v += 3) {
+                        const Byte d[] = {INS_ADC_IM, Byte(v)};
+                        mem.LoadFromData(d, sizeof(d));
+                        cpu.PC = 0;
+                        cpu.A = a;
+                        cpu.SetCarry(carry);
+                        cpu.DecimalMode = decimal;
+                        cpu.RunOneInstruction();
+
+                        Reference ref = {Byte(a), Byte(carry), Byte(decimal), 0, 0, 0};
+                        ref.Adc(a, v);
+                        TS_ASSERT_EQUALS(cpu.A, ref.A);
+                        TS_ASSERT_EQUALS(cpu.GetCarry(), ref.Carry);
+                        TS_ASSERT_EQUALS(cpu.GetZero(), ref.Zero);
+                        TS_ASSERT_EQUALS(cpu.GetOverflow(), ref.Overflow);
+                        TS_ASSERT_EQUALS(cpu.GetNegative(), ref.Negative);
+                    }
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+#include <aot_cpu.h>
+
+// LDA #$01 / ASL A / ASL A / BNE -4 / LDX #$05 / (unknown opcode), translated
+// from $8000
+#include "aot_test_program.inc"
+
+class AotCPU_Tests : public CxxTest::TestSuite 
+{
+public:
+    AotCPU*  cpu;
+    Mem* mem;
+
+    static constexpr Byte program[] = {0xA9, 0x01, 0x0A, 0x0A, 0xD0, 0xFC, 0xA2, 0x05, 0xFF};
+    static constexpr Word pc_start = 0x8000;
+
+    void setUp() {
+        mem= new Mem();
+        mem->LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        cpu = new AotCPU(mem, aot_test_program);
+        cpu->PC = pc_start;
+    }
+
+    void tearDown() {
+        delete cpu;
+        delete mem;
+    }
+
+    void test_AotCompile_should_trace_blocks( void ) {
+        std::string source = AotCompile(*mem, {pc_start}, "aot_test_program");
+
+        TS_ASSERT(source.find("Block<AotRom_aot_test_program, 0x8000>") != std::string::npos);
+        TS_ASSERT(source.find("Block<AotRom_aot_test_program, 0x8002>") != std::string::npos);
+        TS_ASSERT(source.find("Block<AotRom_aot_test_program, 0x8006>") != std::string::npos);
+        TS_ASSERT(source.find("{aot_test_program_blocks, 3}") != std::string::npos);
+    }
+
+    void test_Run_should_match_CPU_Run( void ) {
+        Mem other_mem;
+        other_mem.LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        CPU other(&other_mem);
+
+        for (u64 budget = 0; budget < 40; ++budget) {
+            other.PC = cpu->PC = pc_start;
+            other.A = cpu->A = 0;
+
+            TS_ASSERT_EQUALS(cpu->Run(budget), other.Run(budget));
+            TS_ASSERT_EQUALS(cpu->PC, other.PC);
+            TS_ASSERT_EQUALS(cpu->A, other.A);
+            TS_ASSERT_EQUALS(cpu->X, other.X);
+            TS_ASSERT_EQUALS(cpu->GetZero(), other.GetZero());
+            TS_ASSERT_EQUALS(cpu->GetCarry(), other.GetCarry());
+        }
+    }
+
+    void test_Should_run_translated_blocks( void ) {
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(program));
+        // [LDA..BNE] [ASL..BNE] x3 [LDX], then the unknown opcode
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, 5);
+        TS_ASSERT_EQUALS(cpu->aot_interpreted, 1);
+        TS_ASSERT_EQUALS(cpu->aot_rejected, 0);
+    }
+
+    void test_Should_interpret_code_that_was_written( void ) {
+        cpu->Run(1000);
+
+        mem->WriteByte(pc_start + 7, 0x09);
+        cpu->PC = pc_start + 6;
+        auto blocks_run = cpu->aot_blocks_run;
+        cpu->Run(2);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x09);
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, blocks_run);
+    }
+
+    void test_Should_reject_blocks_not_matching_memory( void ) {
+        const Byte other_program[] = {0xA9, 0x02, 0x0A, 0x0A, 0xD0, 0xFC, 0xA2, 0x06, 0xFF};
+        mem->LoadFromDataAtOffset(other_program, sizeof(other_program), pc_start);
+        cpu->PC = pc_start;
+
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x06);
+        // only [ASL..BNE] still matches
+        TS_ASSERT_EQUALS(cpu->aot_rejected, 2);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(other_program));
+    }
+
+    void test_Should_run_the_code_a_bank_maps_in( void ) {
+        // LDX #$77 / (unknown opcode)
+        static const Byte bank[Mem::page_size] = {0xA2, 0x77, 0xFF};
+        mem->MapBank(0x80, 1, bank);
+
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x77);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + 3);
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, 0);
+
+        // and the translated blocks again once the RAM is mapped back
+        mem->MapRAM(0x80, 1);
+        cpu->PC = pc_start;
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x05);
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, 5);
+
+        mem->MapBank(0x80, 1, bank);
+        cpu->PC = pc_start;
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x77);
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, 5);
+    }
+
+    void test_Should_not_translate_code_on_io_pages( void ) {
+        struct Rom : MemDevice {
+            Byte Read(Word addr) override { return program[addr & 0xFF]; }
+            void Write(Word, Byte) override {}
+        } rom;
+        mem->MapIO(0x80, 1, &rom);
+
+        cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x05);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(program));
+        TS_ASSERT_EQUALS(cpu->aot_blocks_run, 0);
+    }
+};
@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <vector>
+#include <batch.h>
+#include <cpu.h>
+#include <mem.h>
+
+class Batch_Tests : public CxxTest::TestSuite
+{
+public:
+
+    /*  Counts $10 up from X to 0, with A counting through 256 each time
+        round, then stops at $8014.
+
+        $8000: STX $10
+        $8002: CLC
+               ADC #$01
+               BNE $8002
+               LDA $10
+               ADC #$00
+               STA $10
+               BEQ $8014
+               LDA #$00
+               BEQ $8002
+        $8014:
+    */
+    static constexpr Word start = 0x8000;
+    static constexpr Word stop = 0x8014;
+
+    std::shared_ptr<const MemImage> image;
+
+    void setUp() {
+        const Byte program[] = {
+            0x86, 0x10,
+            0x18,
+            0x69, 0x01,
+            0xD0, 0xFB,
+            0xA5, 0x10,
+            0x69, 0x00,
+            0x85, 0x10,
+            0xF0, 0x05,
+            0xA9, 0x00,
+            0xF0, 0xEF,
+        };
+        image = std::make_shared<const MemImage>(program, sizeof(program), start);
+    }
+
+    std::vector<BatchJob> Jobs(size_t count) {
+        std::vector<BatchJob> jobs(count);
+        for (size_t i = 0; i < count; ++i) {
+            jobs[i].image = image;
+            jobs[i].pc = start;
+            jobs[i].X = Byte(0xFF - i * 7);
+            jobs[i].stop_pc = stop;
+            jobs[i].result_addr = 0x0010;
+        }
+        return jobs;
+    }
+
+    void CheckAgainstCpu(const std::vector<BatchJob>& jobs, const std::vector<BatchResult>& results) {
+        TS_ASSERT_EQUALS( results.size(), jobs.size() );
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            Mem mem;
+            mem.LoadShared(image);
+            CPU cpu(&mem);
+            cpu.PC = jobs[i].pc;
+            cpu.X = jobs[i].X;
+            u64 cycles = cpu.RunUntil(stop);
+            TS_ASSERT_EQUALS( results[i].status, BATCH_STOPPED );
+            TS_ASSERT_EQUALS( results[i].cycles, cycles );
+            TS_ASSERT_EQUALS( results[i].PC, stop );
+            TS_ASSERT_EQUALS( results[i].A, cpu.A );
+            TS_ASSERT_EQUALS( results[i].X, jobs[i].X );
+            TS_ASSERT_EQUALS( results[i].P, cpu.GetStatus() );
+            TS_ASSERT_EQUALS( results[i].result, 0x00 );
+        }
+    }
+
+    void test_Should_run_every_job_to_its_stop_pc( void ) {
+        std::vector<BatchJob> jobs = Jobs(20);
+        BatchRunner runner(1);
+        std::vector<BatchResult> results = runner.Run(jobs);
+        CheckAgainstCpu(jobs, results);
+        u64 total = 0;
+        for (const BatchResult& r : results) {
+            total += r.cycles;
+        }
+        TS_ASSERT_EQUALS( runner.cycles, total );
+        TS_ASSERT( runner.EmulatedMHz() > 0 );
+    }
+
+    void test_Should_give_the_same_results_on_many_threads( void ) {
+        std::vector<BatchJob> jobs = Jobs(30);
+        BatchRunner runner(4);
+        runner.quantum = 1000;
+        CheckAgainstCpu(jobs, runner.Run(jobs));
+    }
+
+    void test_Should_stop_jobs_out_of_cycles( void ) {
+        std::vector<BatchJob> jobs = Jobs(3);
+        jobs[1].max_cycles = 5000;
+        BatchRunner runner(2);
+        runner.quantum = 2000;
+        std::vector<BatchResult> results = runner.Run(jobs);
+        TS_ASSERT_EQUALS( results[0].status, BATCH_STOPPED );
+        TS_ASSERT_EQUALS( results[1].status, BATCH_OUT_OF_CYCLES );
+        TS_ASSERT( results[1].cycles >= 5000 );
+        TS_ASSERT( results[1].cycles < 5010 );
+        TS_ASSERT_EQUALS( results[2].status, BATCH_STOPPED );
+    }
+
+    void test_Should_run_an_empty_batch( void ) {
+        BatchRunner runner;
+        TS_ASSERT( runner.threads >= 1 );
+        TS_ASSERT( runner.Run({}).empty() );
+        TS_ASSERT_EQUALS( runner.cycles, 0u );
+    }
+};
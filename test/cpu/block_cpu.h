@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+#include <block_cpu.h>
+
+class BlockCPU_Tests : public CxxTest::TestSuite 
+{
+public:
+    BlockCPU*  cpu;
+    Mem* mem;
+
+    // LDA #$01 / ASL A / ASL A / BNE -4 / LDX #$05 / (unknown opcode)
+    static constexpr Byte program[] = {0xA9, 0x01, 0x0A, 0x0A, 0xD0, 0xFC, 0xA2, 0x05, 0xFF};
+    static constexpr Word pc_start = 0x8000;
+
+    void setUp() {
+        mem= new Mem();
+        mem->LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        cpu = new BlockCPU(mem);
+        cpu->PC = pc_start;
+    }
+
+    void tearDown() {
+        delete cpu;
+        delete mem;
+    }
+
+    void test_Run_should_match_CPU_Run( void ) {
+        Mem other_mem;
+        other_mem.LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        CPU other(&other_mem);
+
+        for (u64 budget = 0; budget < 40; ++budget) {
+            other.PC = cpu->PC = pc_start;
+            other.A = cpu->A = 0;
+
+            TS_ASSERT_EQUALS(cpu->Run(budget), other.Run(budget));
+            TS_ASSERT_EQUALS(cpu->PC, other.PC);
+            TS_ASSERT_EQUALS(cpu->A, other.A);
+            TS_ASSERT_EQUALS(cpu->X, other.X);
+            TS_ASSERT_EQUALS(cpu->GetZero(), other.GetZero());
+            TS_ASSERT_EQUALS(cpu->GetCarry(), other.GetCarry());
+        }
+    }
+
+    void test_Should_count_hits_and_misses( void ) {
+        auto cycles = cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cycles, 2 + 3 * (2 + 2 + 3) + (2 + 2 + 2) + 2);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(program));
+        // [LDA..BNE] [ASL..BNE] x3 [LDX] [unknown]
+        TS_ASSERT_EQUALS(cpu->block_misses, 4);
+        TS_ASSERT_EQUALS(cpu->block_hits, 2);
+        TS_ASSERT_EQUALS(cpu->block_chains, 1);
+    }
+
+    void test_Should_retranslate_after_code_is_written( void ) {
+        cpu->Run(1000);
+        auto misses = cpu->block_misses;
+
+        mem->WriteByte(pc_start + 7, 0x09);
+        cpu->PC = pc_start + 6;
+        cpu->Run(2);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x09);
+        TS_ASSERT_EQUALS(cpu->block_misses, misses + 1);
+    }
+
+    void test_Should_keep_retranslating_code_that_is_written( void ) {
+        cpu->Run(1000);
+        auto misses = cpu->block_misses;
+
+        for (Byte x = 0; x < 200; ++x) {
+            mem->WriteByte(pc_start + 7, x);
+            cpu->PC = pc_start;
+            cpu->Run(1000);
+            TS_ASSERT_EQUALS(cpu->X, x);
+        }
+        // only [LDX] is on the byte written
+        TS_ASSERT_EQUALS(cpu->block_misses, misses + 200);
+    }
+
+    void test_Should_run_code_written_over_an_unknown_opcode( void ) {
+        // LDA #$01 / (unknown opcode), then LDX #$05 written over it
+        const Byte d[] = {0xA9, 0x01, 0xFF};
+        const Byte patch[] = {0xA2, 0x05};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        cpu->PC = pc_start;
+        cpu->Run(100);
+
+        Mem other_mem;
+        other_mem.LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        CPU other(&other_mem);
+        for (Byte i = 0; i < sizeof(patch); ++i) {
+            mem->WriteByte(pc_start + 2 + i, patch[i]);
+            other_mem.WriteByte(pc_start + 2 + i, patch[i]);
+        }
+        other.PC = cpu->PC = pc_start;
+
+        TS_ASSERT_EQUALS(cpu->Run(100), other.Run(100));
+        TS_ASSERT_EQUALS(cpu->PC, other.PC);
+        TS_ASSERT_EQUALS(cpu->X, 0x05);
+    }
+
+    void test_Should_stop_on_code_written_by_the_block( void ) {
+        // STX $8004 / LDA #$00 / BNE +0 ; the store replaces the LDA operand
+        const Byte d[] = {0x8E, 0x04, 0x80, 0xA9, 0x00, 0xD0, 0x00};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        cpu->X = 0x33;
+        cpu->PC = pc_start;
+
+        cpu->Run(4 + 2 + 2);
+
+        TS_ASSERT_EQUALS(cpu->A, 0x33);
+        TS_ASSERT_EQUALS(cpu->block_misses, 2);
+    }
+};
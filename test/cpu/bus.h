@@ -0,0 +1,51 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <cpu.h>
+#include <mem.h>
+#include "../../bench/bench.h"
+
+class Bus_Tests : public CxxTest::TestSuite
+{
+public:
+
+    /*  64 KB of RAM with inline accesses, as an embedder would write it. */
+    struct FlatBus {
+        Byte data[Mem::max_mem_size] = {};
+        Byte ReadByte(Word addr) { return data[addr]; }
+        Byte WriteByte(Word addr, Byte v) { return data[addr] = v; }
+        Word ReadWord(Word addr) { return data[addr] | data[Word(addr + 1)] << 8; }
+    };
+
+    void test_Should_run_on_any_bus_like_on_mem( void ) {
+        FlatBus bus;
+        memcpy(bus.data + bench_origin, bench_program, sizeof(bench_program));
+        Mem mem;
+        mem.LoadFromData(bus.data, sizeof(bus.data));
+
+        BasicCPU<Nmos6502, FlatBus> flat(&bus);
+        CPU cpu(&mem);
+        flat.PC = cpu.PC = bench_origin;
+        TS_ASSERT_EQUALS( flat.Run(10000), cpu.Run(10000) );
+        TS_ASSERT_EQUALS( flat.PC, cpu.PC );
+        TS_ASSERT_EQUALS( flat.A, cpu.A );
+        TS_ASSERT_EQUALS( flat.X, cpu.X );
+        TS_ASSERT_EQUALS( flat.GetStatus(), cpu.GetStatus() );
+        TS_ASSERT_SAME_DATA( bus.data, mem.m_data, sizeof(bus.data) );
+
+        TS_ASSERT_EQUALS( flat.RunOneInstruction(), cpu.RunOneInstruction() );
+        TS_ASSERT_EQUALS( flat.PC, cpu.PC );
+    }
+
+    void test_Should_use_the_65C02_opcodes_on_any_bus( void ) {
+        // LDA ($10)
+        const Byte d[] = { 0xB2, 0x10 };
+        FlatBus bus;
+        memcpy(bus.data, d, sizeof(d));
+        bus.data[0x10] = 0x34;
+        bus.data[0x11] = 0x12;
+        bus.data[0x1234] = 0x56;
+        BasicCPU<Cmos65C02, FlatBus> cpu(&bus);
+        TS_ASSERT_EQUALS( cpu.RunOneInstruction(), 5u );
+        TS_ASSERT_EQUALS( cpu.A, 0x56 );
+    }
+};
@@ -0,0 +1,197 @@
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cpu_bank.h>
+#include <cpu.h>
+#include <mem.h>
+
+class CpuBank_Tests : public CxxTest::TestSuite
+{
+public:
+
+    static constexpr size_t lanes = 70;     // two full vectors and part of a third
+
+    struct Lane {
+        std::unique_ptr<Mem> bank_mem;
+        std::unique_ptr<Mem> cpu_mem;
+        std::unique_ptr<CPU> cpu;
+        u64 cycles = 0;
+        bool stopped = false;
+    };
+
+    /*  Loads lane i of bank and a CPU next to it with the same registers,
+        each on its own copy of image. Odd lanes share image instead.
+    */
+    std::vector<Lane> Start(CpuBank& bank, const std::vector<Byte>& image, Word pc, u32 seed) {
+        auto shared = std::make_shared<const MemImage>(image.data(), image.size());
+        std::mt19937 random(seed);
+        std::vector<Lane> result(bank.Lanes());
+        for (size_t i = 0; i < result.size(); ++i) {
+            Lane& lane = result[i];
+            lane.bank_mem.reset(new Mem());
+            lane.cpu_mem.reset(new Mem());
+            if (i & 1) {
+                lane.bank_mem->LoadShared(shared);
+                lane.cpu_mem->LoadShared(shared);
+            } else {
+                lane.bank_mem->LoadFromData(image.data(), image.size());
+                lane.cpu_mem->LoadFromData(image.data(), image.size());
+            }
+            lane.cpu.reset(new CPU(lane.cpu_mem.get()));
+            CPU& cpu = *lane.cpu;
+            cpu.PC = pc;
+            cpu.A = Byte(random());
+            cpu.X = Byte(random());
+            cpu.Y = Byte(random());
+            cpu.SP = Byte(random());
+            cpu.SetStatus(Byte(random()));
+
+            CPU start(lane.bank_mem.get());
+            start.PC = cpu.PC;
+            start.A = cpu.A;
+            start.X = cpu.X;
+            start.Y = cpu.Y;
+            start.SP = cpu.SP;
+            start.SetStatus(cpu.GetStatus());
+            bank.Load(i, start);
+        }
+        return result;
+    }
+
+    /*  Steps bank and every CPU steps times, checking after each step that
+        every lane matches its CPU.
+    */
+    void StepAndCompare(CpuBank& bank, std::vector<Lane>& cpus, size_t steps) {
+        for (size_t step = 0; step < steps; ++step) {
+            bank.Step();
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                Lane& lane = cpus[i];
+                if (!lane.stopped) {
+                    u32 used = lane.cpu->RunOneInstruction();
+                    lane.stopped = used == 0;
+                    lane.cycles += used;
+                }
+                const CPU& cpu = *lane.cpu;
+                if (bank.PC[i] != cpu.PC || bank.A[i] != cpu.A || bank.X[i] != cpu.X || bank.Y[i] != cpu.Y
+                    || bank.SP[i] != cpu.SP || bank.P[i] != cpu.GetStatus() || bank.cycles[i] != lane.cycles
+                    || bool(bank.stopped[i]) != lane.stopped)
+                {
+                    TS_TRACE( "step " + std::to_string(step) + ", lane " + std::to_string(i) );
+                    TS_ASSERT_EQUALS( bank.PC[i], cpu.PC );
+                    TS_ASSERT_EQUALS( bank.A[i], cpu.A );
+                    TS_ASSERT_EQUALS( bank.X[i], cpu.X );
+                    TS_ASSERT_EQUALS( bank.Y[i], cpu.Y );
+                    TS_ASSERT_EQUALS( bank.SP[i], cpu.SP );
+                    TS_ASSERT_EQUALS( bank.P[i], cpu.GetStatus() );
+                    TS_ASSERT_EQUALS( bank.cycles[i], lane.cycles );
+                    TS_ASSERT_EQUALS( bool(bank.stopped[i]), lane.stopped );
+                    return;
+                }
+            }
+        }
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            for (u32 addr = 0; addr < Mem::max_mem_size; ++addr) {
+                if (cpus[i].bank_mem->ReadByte(addr) != cpus[i].cpu_mem->ReadByte(addr)) {
+                    TS_TRACE( "lane " + std::to_string(i) );
+                    TS_ASSERT_EQUALS( cpus[i].bank_mem->ReadByte(addr), cpus[i].cpu_mem->ReadByte(addr) );
+                    return;
+                }
+            }
+        }
+    }
+
+    void test_Should_match_the_cpu_on_random_code( void ) {
+        // every byte, operands included, an implemented opcode, so lanes
+        // rarely stop wherever branches and stores take them
+        std::vector<Byte> implemented;
+        for (u32 opcode = 0; opcode < 0x100; ++opcode) {
+            if (opcode_info[opcode].implemented) {
+                implemented.push_back(Byte(opcode));
+            }
+        }
+        std::mt19937 random(6502);
+        std::vector<Byte> image(Mem::max_mem_size);
+        for (Byte& b : image) {
+            b = implemented[random() % implemented.size()];
+        }
+
+        for (bool simd : {true, false}) {
+            CpuBank bank(lanes);
+            bank.simd = simd && CpuBank::HasSimd();
+            bank.min_group = 2;
+            std::vector<Lane> cpus = Start(bank, image, 0x0200, 1);
+            StepAndCompare(bank, cpus, 3000);
+            if (bank.simd) {
+                TS_ASSERT( bank.simd_steps > 0 );
+            } else {
+                TS_ASSERT_EQUALS( bank.simd_steps, 0u );
+            }
+        }
+    }
+
+    /*  Counts $10 up from X to 0 as in test/cpu/batch.h, so the lanes run
+        the inner loop together and split up at the outer one, then wait at
+        $8014.
+    */
+    void test_Should_run_lanes_at_one_pc_together( void ) {
+        const Byte program[] = {
+            0x86, 0x10,
+            0x18,
+            0x69, 0x01,
+            0xD0, 0xFB,
+            0xA5, 0x10,
+            0x69, 0x00,
+            0x85, 0x10,
+            0xF0, 0x05,
+            0xA9, 0x00,
+            0xF0, 0xEF,
+            0x00,
+            0xF0, 0xFE,     // $8014: BEQ $8014
+        };
+        std::vector<Byte> image(Mem::max_mem_size);
+        std::copy(program, program + sizeof(program), image.begin() + 0x8000);
+
+        CpuBank bank(lanes);
+        std::vector<Lane> cpus = Start(bank, image, 0x8000, 2);
+        for (size_t i = 0; i < lanes; ++i) {
+            // no decimal mode, and a few outer iterations each
+            bank.P[i] &= ~0x08;
+            cpus[i].cpu->SetStatus(bank.P[i]);
+            bank.X[i] = cpus[i].cpu->X = Byte(0xF0 + i % 16);
+        }
+        StepAndCompare(bank, cpus, 20000);
+        if (CpuBank::HasSimd()) {
+            TS_ASSERT( bank.simd_steps > 10 * bank.scalar_steps );
+        }
+    }
+
+    void test_Should_run_each_lane_for_a_cycle_budget( void ) {
+        // LDA #$01 / ADC #$01 / BNE back
+        const Byte program[] = { 0xA9, 0x01, 0x69, 0x01, 0xD0, 0xFC };
+        std::vector<Byte> image(Mem::max_mem_size);
+        std::copy(program, program + sizeof(program), image.begin() + 0x0400);
+
+        CpuBank bank(lanes);
+        std::vector<Lane> cpus = Start(bank, image, 0x0400, 3);
+        for (size_t i = 0; i < lanes; ++i) {
+            bank.P[i] &= ~0x08;
+            cpus[i].cpu->SetStatus(bank.P[i]);
+        }
+        bank.Run(1000);
+        for (size_t i = 0; i < lanes; ++i) {
+            u64 cycles = cpus[i].cpu->Run(1000);
+            TS_ASSERT_EQUALS( bank.cycles[i], cycles );
+            TS_ASSERT_EQUALS( bank.PC[i], cpus[i].cpu->PC );
+            TS_ASSERT_EQUALS( bank.A[i], cpus[i].cpu->A );
+            TS_ASSERT_EQUALS( bank.P[i], cpus[i].cpu->GetStatus() );
+
+            CPU cpu(nullptr);
+            bank.Store(i, cpu);
+            TS_ASSERT_EQUALS( cpu.mem, cpus[i].bank_mem.get() );
+            TS_ASSERT_EQUALS( cpu.A, bank.A[i] );
+            TS_ASSERT_EQUALS( cpu.GetStatus(), bank.P[i] );
+        }
+    }
+};
@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+#include <decode_cache.h>
+
+class DecodeCache_Tests : public CxxTest::TestSuite 
+{
+public:
+    CPU*  cpu;
+    Mem* mem;
+    DecodeCache* cache;
+    static constexpr Word pc_start = 0x8000;
+
+    void setUp() {
+        mem= new Mem();
+        cpu = new CPU(mem);
+        cache = new DecodeCache(mem);
+        cpu->decode_cache = cache;
+    }
+
+    void tearDown() {
+        delete cache;
+        delete cpu;
+        delete mem;
+    }
+
+    void test_Should_hit_on_second_run( void ) {
+        // LDA #$42 / LDX $10
+        const Byte d[] = {0xA9, 0x42, 0xA6, 0x10};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            cpu->PC = pc_start;
+            TS_ASSERT_EQUALS(cpu->RunOneInstruction(), 2);
+            TS_ASSERT_EQUALS(cpu->RunOneInstruction(), 3);
+            TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(d));
+            TS_ASSERT_EQUALS(cpu->A, 0x42);
+        }
+        TS_ASSERT_EQUALS(cache->misses, 2);
+        TS_ASSERT_EQUALS(cache->hits, 2);
+    }
+
+    void test_Should_decode_again_after_write_to_operand( void ) {
+        // LDA #$42
+        const Byte d[] = {0xA9, 0x42};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+        mem->WriteByte(pc_start + 1, 0x17);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        TS_ASSERT_EQUALS(cpu->A, 0x17);
+        TS_ASSERT_EQUALS(cache->misses, 2);
+    }
+
+    void test_Should_keep_entries_on_unrelated_write( void ) {
+        // LDA #$42
+        const Byte d[] = {0xA9, 0x42};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+        mem->WriteByte(pc_start + 2, 0x17);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        TS_ASSERT_EQUALS(cache->misses, 1);
+        TS_ASSERT_EQUALS(cache->hits, 1);
+    }
+
+    void test_Should_see_code_written_by_the_program( void ) {
+        // STX $8005 / LDA #$00 ; the store replaces the LDA operand
+        const Byte d[] = {0x8E, 0x05, 0x80, 0xEA, 0xA9, 0x00};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+
+        cpu->PC = pc_start + 4;
+        cpu->RunOneInstruction();
+        TS_ASSERT_EQUALS(cpu->A, 0x00);
+
+        cpu->X = 0x33;
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+        cpu->PC = pc_start + 4;
+        cpu->RunOneInstruction();
+        TS_ASSERT_EQUALS(cpu->A, 0x33);
+    }
+
+    void test_Should_drop_everything_on_reload( void ) {
+        const Byte d1[] = {0xA9, 0x42};
+        const Byte d2[] = {0xA2, 0x42};
+        mem->LoadFromDataAtOffset(d1, sizeof(d1), pc_start);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        mem->LoadFromDataAtOffset(d2, sizeof(d2), pc_start);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        TS_ASSERT_EQUALS(cpu->X, 0x42);
+        TS_ASSERT_EQUALS(cache->misses, 2);
+    }
+
+    void test_Run_should_use_the_cache( void ) {
+        // LDA #$01 / ASL A / BNE -3
+        const Byte d[] = {0xA9, 0x01, 0x0A, 0xD0, 0xFD};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+
+        cpu->PC = pc_start;
+        auto cycles = cpu->RunUntil(Word(pc_start + sizeof(d)));
+
+        TS_ASSERT_EQUALS(cycles, 2 + 7 * (2 + 3) + (2 + 2));
+        TS_ASSERT_EQUALS(cache->misses, 3);
+        TS_ASSERT_EQUALS(cache->hits, 14);
+    }
+
+    void test_Should_drop_entries_written_through_a_mirror( void ) {
+        // LDA #$42, run from $8000 and written through a mirror at $0000
+        const Byte d[] = {0xA9, 0x42};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        mem->MapMirror(0x00, 1, pc_start >> 8);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        mem->WriteByte(0x0001, 0x43);
+        cpu->PC = pc_start;
+        cpu->RunOneInstruction();
+
+        TS_ASSERT_EQUALS(cpu->A, 0x43);
+        TS_ASSERT_EQUALS(cache->misses, 2);
+    }
+};
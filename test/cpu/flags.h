@@ -0,0 +1,53 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+
+class Flags_Tests : public CxxTest::TestSuite 
+{
+public:
+    CPU*  cpu;
+
+    void setUp() {
+        cpu = new CPU(nullptr);
+    }
+
+    void tearDown() {
+        delete cpu;
+    }
+
+    void test_Should_start_with_flags_clear( void ) {
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+    }
+
+    void test_Should_read_back_set_flags( void ) {
+        for (Byte v = 0; v < 2; ++v) {
+            cpu->SetCarry(v);
+            cpu->SetZero(v);
+            cpu->SetOverflow(v);
+            cpu->SetNegative(v);
+
+            TS_ASSERT_EQUALS(cpu->GetCarry(), v);
+            TS_ASSERT_EQUALS(cpu->GetZero(), v);
+            TS_ASSERT_EQUALS(cpu->GetOverflow(), v);
+            TS_ASSERT_EQUALS(cpu->GetNegative(), v);
+        }
+    }
+
+    void test_Status_should_pack_flags( void ) {
+        cpu->InterruptDisable = 0;
+        TS_ASSERT_EQUALS(cpu->GetStatus(), 0x20);
+
+        cpu->SetNegative(1);
+        cpu->SetCarry(1);
+        TS_ASSERT_EQUALS(cpu->GetStatus(), 0xA1);
+    }
+
+    void test_SetStatus_should_round_trip( void ) {
+        for (u32 p = 0; p < 0x100; ++p) {
+            cpu->SetStatus(p);
+            TS_ASSERT_EQUALS(cpu->GetStatus(), p | 0x20);
+        }
+    }
+};
@@ -0,0 +1,196 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <vector>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fuzz.h>
+
+class Fuzz_Tests : public CxxTest::TestSuite
+{
+public:
+
+    /*  Crashes on an unknown opcode when the input starts with "FUZ!",
+        checking a byte at a time, and otherwise stops at $8015 (or loops
+        there for ever if stop_pc is elsewhere).
+
+        $8000: LDX #$00
+        $8002: CLC
+               LDA $0200,X
+               ADC $8020,X     ; minus the byte expected
+               BNE $8015
+               TXA
+               CLC
+               ADC #$01
+               TAX
+               AND #$04
+               BEQ $8002
+        $8014: .byte $02
+        $8015: BNE $8015
+        $8020: .byte -'F', -'U', -'Z', -'!'
+    */
+    std::vector<Byte> Program() {
+        const Byte code[] = {
+            0xA2, 0x00,
+            0x18,
+            0xBD, 0x00, 0x02,
+            0x7D, 0x20, 0x80,
+            0xD0, 0x0A,
+            0x8A,
+            0x18,
+            0x69, 0x01,
+            0xAA,
+            0x29, 0x04,
+            0xF0, 0xEE,
+            0x02,
+            0xD0, 0xFE,
+        };
+        std::vector<Byte> program(0x24);
+        memcpy(program.data(), code, sizeof(code));
+        const char magic[] = "FUZ!";
+        for (int i = 0; i < 4; ++i) {
+            program[0x20 + i] = Byte(0x100 - magic[i]);
+        }
+        return program;
+    }
+
+    FuzzConfig Config() {
+        FuzzConfig config;
+        config.entry = 0x8000;
+        config.stop_pc = 0x8015;
+        config.max_cycles = 1000;
+        return config;
+    }
+
+    static size_t Edges(const Byte* map) {
+        size_t edges = 0;
+        for (size_t i = 0; i < Fuzzer::map_size; ++i) {
+            edges += map[i] != 0;
+        }
+        return edges;
+    }
+
+    static size_t Hits(const Byte* map) {
+        size_t hits = 0;
+        for (size_t i = 0; i < Fuzzer::map_size; ++i) {
+            hits += map[i];
+        }
+        return hits;
+    }
+
+    FuzzStatus Run(Fuzzer& fuzzer, const char* input) {
+        return fuzzer.Run(reinterpret_cast<const Byte*>(input), strlen(input));
+    }
+
+    void test_Should_find_the_crash( void ) {
+        Fuzzer fuzzer(Config());
+        std::vector<Byte> program = Program();
+        fuzzer.LoadFromData(program.data(), program.size(), 0x8000);
+
+        TS_ASSERT_EQUALS( Run(fuzzer, "xxxx"), FUZZ_STOPPED );
+        TS_ASSERT_EQUALS( fuzzer.PC, 0x8015 );
+        size_t none = Edges(fuzzer.map);
+        TS_ASSERT_EQUALS( Run(fuzzer, "Fxxx"), FUZZ_STOPPED );
+        TS_ASSERT( Edges(fuzzer.map) > none );
+        // the same edges, taken more often
+        size_t one = Hits(fuzzer.map);
+        TS_ASSERT_EQUALS( Run(fuzzer, "FUZx"), FUZZ_STOPPED );
+        TS_ASSERT( Hits(fuzzer.map) > one );
+
+        TS_ASSERT_EQUALS( Run(fuzzer, "FUZ!"), FUZZ_CRASH );
+        TS_ASSERT_EQUALS( fuzzer.PC, 0x8014 );
+        TS_ASSERT_EQUALS( fuzzer.runs, 4u );
+    }
+
+    void test_Should_restore_memory_between_runs( void ) {
+        Fuzzer fuzzer(Config());
+        std::vector<Byte> program = Program();
+        fuzzer.LoadFromData(program.data(), program.size(), 0x8000);
+
+        TS_ASSERT_EQUALS( Run(fuzzer, "FU"), FUZZ_STOPPED );
+        std::vector<Byte> first(fuzzer.map, fuzzer.map + Fuzzer::map_size);
+        u64 cycles = fuzzer.cycles;
+        TS_ASSERT_EQUALS( Run(fuzzer, "FUZ!"), FUZZ_CRASH );
+        // "Z!" is gone again, so this is the first run over
+        TS_ASSERT_EQUALS( Run(fuzzer, "FU"), FUZZ_STOPPED );
+        TS_ASSERT_EQUALS( fuzzer.cycles, cycles );
+        TS_ASSERT_SAME_DATA( fuzzer.map, first.data(), Fuzzer::map_size );
+    }
+
+    void test_Should_time_out( void ) {
+        FuzzConfig config = Config();
+        config.stop_pc = 0x9000;
+        Fuzzer fuzzer(config);
+        std::vector<Byte> program = Program();
+        fuzzer.LoadFromData(program.data(), program.size(), 0x8000);
+        TS_ASSERT_EQUALS( Run(fuzzer, "x"), FUZZ_TIMEOUT );
+        TS_ASSERT( fuzzer.cycles >= config.max_cycles );
+        TS_ASSERT_EQUALS( fuzzer.PC, 0x8015 );
+    }
+
+    /*  Plays afl-fuzz against a fork server with two inputs per child,
+        handing inputs over in shared memory.
+    */
+    void test_Should_serve_forks_like_afl( void ) {
+        int control[2], status[2];
+        TS_ASSERT_EQUALS( pipe(control), 0 );
+        TS_ASSERT_EQUALS( pipe(status), 0 );
+        void* shared = mmap(nullptr, Fuzzer::map_size + 0x100, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        TS_ASSERT( shared != MAP_FAILED );
+        Byte* map = static_cast<Byte*>(shared);
+        char* input = reinterpret_cast<char*>(map + Fuzzer::map_size);
+
+        pid_t server = fork();
+        if (server == 0) {
+            close(control[1]);
+            close(status[0]);
+            Fuzzer fuzzer(Config());
+            std::vector<Byte> program = Program();
+            fuzzer.LoadFromData(program.data(), program.size(), 0x8000);
+            fuzzer.map = map;
+            if (fuzzer.ServeForks(true, control[0], status[1])) {
+                while (fuzzer.Loop(2)) {
+                    if (Run(fuzzer, input) == FUZZ_CRASH) {
+                        abort();
+                    }
+                }
+            }
+            _exit(0);
+        }
+        close(control[0]);
+        close(status[1]);
+        u32 hello;
+        TS_ASSERT_EQUALS( read(status[0], &hello, 4), 4 );
+
+        auto run = [&](const char* text, pid_t& pid) {
+            strcpy(input, text);
+            memset(map, 0, Fuzzer::map_size);
+            u32 was_killed = 0;
+            int result = -1;
+            pid = -1;
+            if (write(control[1], &was_killed, 4) != 4 || read(status[0], &pid, 4) != 4
+                || read(status[0], &result, 4) != 4) {
+                TS_FAIL( "fork server went away" );
+            }
+            return result;
+        };
+        pid_t first, second, third;
+        int result = run("xxxx", first);
+        TS_ASSERT( WIFSTOPPED(result) );
+        TS_ASSERT( Edges(map) > 0 );
+        result = run("Fxxx", second);
+        TS_ASSERT_EQUALS( second, first );
+        TS_ASSERT( WIFEXITED(result) && WEXITSTATUS(result) == 0 );
+        result = run("FUZ!", third);
+        TS_ASSERT_DIFFERS( third, first );
+        TS_ASSERT( WIFSIGNALED(result) && WTERMSIG(result) == SIGABRT );
+
+        close(control[1]);
+        int server_status;
+        TS_ASSERT_EQUALS( waitpid(server, &server_status, 0), server );
+        close(status[0]);
+        munmap(shared, Fuzzer::map_size + 0x100);
+    }
+};
@@ -30,21 +30,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_add_with_zero( void ) {
@@ -55,21 +55,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_add_with_nonzero_and_carry( void ) {
@@ -80,21 +80,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_add_with_zero_and_carry( void ) {
@@ -105,21 +105,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
 
@@ -131,21 +131,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_set_negative_and_overflow( void ) {
@@ -156,21 +156,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
-        cpu->Overflow = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
+        cpu->SetOverflow(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_set_carry_from_overflowing_bit_7( void ) {
@@ -181,21 +181,21 @@ public:
 
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
-        cpu->Overflow = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
+        cpu->SetOverflow(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_Should_work_in_DecimalMode( void ) {
@@ -207,21 +207,21 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->DecimalMode = 1;
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_add_Carry_in_DecimalMode( void ) {
@@ -233,21 +233,21 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->DecimalMode = 1;
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_work_in_DecimalMode_with_halfcarry( void ) {
@@ -259,21 +259,21 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->DecimalMode = 1;
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_Should_work_in_DecimalMode_with_halfcarry_and_fullcarry( void ) {
@@ -285,21 +285,21 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->DecimalMode = 1;
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
-        cpu->Overflow = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
+        cpu->SetOverflow(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
 };
\ No newline at end of file
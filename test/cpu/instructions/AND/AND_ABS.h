@@ -34,16 +34,16 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = A_val;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_ClearZero_ClearNegative( void ) {
@@ -58,16 +58,16 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_ClearZero_SetNegative( void ) {
@@ -82,16 +82,16 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
     
 };
\ No newline at end of file
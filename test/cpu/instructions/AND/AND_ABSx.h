@@ -36,8 +36,8 @@ public:
 
         cpu->X = offset;
         cpu->A = A_val;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -45,8 +45,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->X, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_ClearZero_ClearNegative( void ) {
@@ -63,8 +63,8 @@ public:
 
         cpu->X = offset;
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -72,8 +72,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->X, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_ClearZero_SetNegative( void ) {
@@ -90,8 +90,8 @@ public:
 
         cpu->X = offset;
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -99,8 +99,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->X, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_Should_ClearZero_SetNegative_WithPageCross( void ) {
@@ -117,8 +117,8 @@ public:
 
         cpu->X = offset;
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -126,8 +126,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->X, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
 };
\ No newline at end of file
@@ -31,16 +31,16 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_SetZero_ClearNegative( void ) {
@@ -52,16 +52,16 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = A_val;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_SetNegative_ClearZero( void ) {
@@ -73,15 +73,15 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = A_val;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 };
\ No newline at end of file
@@ -30,18 +30,18 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithZero_CarrySet( void ) {
@@ -52,18 +52,18 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 1;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_NoCarrySet_NoCarry( void ) {
@@ -74,18 +74,18 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_NoCarrySet_WithCarry( void ) {
@@ -96,18 +96,18 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithNonZero_CarrySet_NoCarry( void ) {
@@ -118,18 +118,18 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_CarrySet_WithCarry( void ) {
@@ -140,17 +140,17 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = test_val;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cpu->A, expect_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 };
\ No newline at end of file
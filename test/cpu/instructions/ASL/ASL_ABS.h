@@ -33,9 +33,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = 0x11;
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -44,9 +44,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithZero_CarrySet( void ) {
         const Byte test_val  = 0b00000000;
@@ -58,9 +58,9 @@ public:
         mem->WriteWord(1, addr);
         mem->WriteByte(addr, test_val);
         cpu->A = 0x11;
-        cpu->Carry = 1;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -69,9 +69,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_NoCarrySet_NoCarry( void ) {
         const Byte test_val  = 0b00110111;
@@ -85,9 +85,9 @@ public:
 
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -96,9 +96,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_CarrySet_NoCarry( void ) {
         const Byte test_val  = 0b00110111;
@@ -111,9 +111,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -122,9 +122,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_NoCarrySet_WithCarry( void ) {
         const Byte test_val  = 0b10110111;
@@ -137,9 +137,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -148,9 +148,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
     void test_WithNonZero_CarrySet_WithCarry( void ) {
         const Byte test_val  = 0b10110111;
@@ -163,9 +163,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -174,8 +174,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 };
\ No newline at end of file
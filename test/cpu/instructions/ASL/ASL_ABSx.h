@@ -35,9 +35,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x11;
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -46,9 +46,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithZero_CarrySet( void ) {
         const Byte test_val  = 0b00000000;
@@ -63,9 +63,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x11;
-        cpu->Carry = 1;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -74,9 +74,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_NoCarrySet_NoCarry( void ) {
         const Byte test_val  = 0b00110111;
@@ -91,9 +91,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -102,9 +102,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_CarrySet_NoCarry( void ) {
         const Byte test_val  = 0b00110111;
@@ -119,9 +119,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -130,9 +130,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
     void test_WithNonZero_NoCarrySet_WithCarry( void ) {
         const Byte test_val  = 0b10110111;
@@ -147,9 +147,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -158,9 +158,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
     void test_WithNonZero_CarrySet_WithCarry( void ) {
         const Byte test_val  = 0b10110111;
@@ -175,9 +175,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -186,8 +186,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 };
\ No newline at end of file
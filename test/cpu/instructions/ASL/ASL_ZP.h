@@ -30,9 +30,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x11;
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -41,9 +41,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithZero_CarrySet( void ) {
@@ -54,9 +54,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x11;
-        cpu->Carry = 1;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -65,9 +65,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_NoCarrySet_NoCarry( void ) {
@@ -78,9 +78,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -89,9 +89,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_CarrySet_NoCarry( void ) {
@@ -102,9 +102,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -113,9 +113,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_NoCarrySet_WithCarry( void ) {
@@ -126,9 +126,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -137,9 +137,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithNonZero_CarrySet_WithCarry( void ) {
@@ -150,9 +150,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -161,8 +161,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 };
\ No newline at end of file
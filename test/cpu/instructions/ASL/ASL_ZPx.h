@@ -33,9 +33,9 @@ public:
 
         cpu->X = offset;
         cpu->A = 0x11;
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -44,9 +44,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithZero_CarrySet( void ) {
@@ -61,9 +61,9 @@ public:
         cpu->X = offset;
 
         cpu->A = 0x11;
-        cpu->Carry = 1;
-        cpu->Zero = 0;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -72,9 +72,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
 
@@ -90,9 +90,9 @@ public:
         cpu->X = offset;
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -101,9 +101,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_CarrySet_NoCarry( void ) {
@@ -118,9 +118,9 @@ public:
         cpu->X = offset;
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -129,9 +129,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNonZero_NoCarrySet_WithCarry( void ) {
@@ -146,9 +146,9 @@ public:
         cpu->X = offset;
 
         cpu->A = 0x00;
-        cpu->Carry = 0;
-        cpu->Zero = 1;
-        cpu->Negative = 0;
+        cpu->SetCarry(0);
+        cpu->SetZero(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -157,9 +157,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithNonZero_CarrySet_WithCarry( void ) {
@@ -174,9 +174,9 @@ public:
         cpu->X = offset;
 
         cpu->A = 0x00;
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -185,8 +185,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 };
\ No newline at end of file
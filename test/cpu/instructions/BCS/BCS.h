@@ -29,13 +29,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 1);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size + relative_value);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithPositiveValue_WithCarrySet_WithPageCross( void ) {
@@ -46,13 +46,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 2);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size + relative_value);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithPositiveValue_WithCarryNotSet( void ) {
@@ -63,13 +63,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 
     void test_WithNegativeValue_WithCarrySet( void ) {
@@ -80,13 +80,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 1);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size - offset);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithNegativeValue_WithCarrySet_WithPageCross( void ) {
@@ -98,13 +98,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 1;
+        cpu->SetCarry(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 2);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size - offset);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
     }
 
     void test_WithNegativeValue_WithCarryNotSet( void ) {
@@ -115,12 +115,12 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Carry = 0;
+        cpu->SetCarry(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
     }
 };
\ No newline at end of file
@@ -36,9 +36,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 0;
-        cpu->Negative = 0;
+        cpu->SetZero(0);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -47,9 +47,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
     void test_Should_SetNotZero_SetOverflow_SetNegative( void ) {
         const Byte test_val = 0b00001001 | overflow_bit | negative_bit;
@@ -62,9 +62,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 0;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -73,9 +73,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
     void test_Should_SetZero_SetNotOverflow_SetNegative( void ) {
         const Byte test_val = 0b00110110 | negative_bit;
@@ -88,9 +88,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(0);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -99,9 +99,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
     void test_Should_SetNotZero_SetNotOverflow_SetNegative( void ) {
         const Byte test_val = 0b00000110 | negative_bit;
@@ -114,9 +114,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -125,9 +125,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
     void test_Should_SetZero_SetOverflow_SetNotNegative( void ) {
         const Byte test_val = 0b00010010 | overflow_bit;
@@ -140,9 +140,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -151,9 +151,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
     void test_Should_SetNotZero_SetOverflow_SetNotNegative( void ) {
         const Byte test_val = 0b00000001 | overflow_bit;
@@ -166,9 +166,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -177,9 +177,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
     void test_Should_SetZero_SetNotOverflow_SetNotNegative( void ) {
         const Byte test_val = 0b00110110;
@@ -192,9 +192,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -203,9 +203,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
     void test_Should_SetNotZero_SetNotOverflow_SetNotNegative( void ) {
         const Byte test_val = 0b00100110 ;
@@ -218,9 +218,9 @@ public:
         mem->WriteByte(addr, test_val);
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -229,8 +229,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 };
\ No newline at end of file
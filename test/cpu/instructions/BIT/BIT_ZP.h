@@ -33,9 +33,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 0;
-        cpu->Negative = 0;
+        cpu->SetZero(0);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -44,9 +44,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_Should_SetNotZero_SetOverflow_SetNegative( void ) {
@@ -57,9 +57,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 0;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -68,9 +68,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_Should_SetZero_SetNotOverflow_SetNegative( void ) {
@@ -81,9 +81,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(0);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -92,9 +92,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_Should_SetNotZero_SetNotOverflow_SetNegative( void ) {
@@ -105,9 +105,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 1;
-        cpu->Negative = 0;
+        cpu->SetZero(1);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -116,9 +116,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_Should_SetZero_SetOverflow_SetNotNegative( void ) {
@@ -129,9 +129,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -140,9 +140,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_SetNotZero_SetOverflow_SetNotNegative( void ) {
@@ -153,9 +153,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 0;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetOverflow(0);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -164,9 +164,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_SetZero_SetNotOverflow_SetNotNegative( void ) {
@@ -177,9 +177,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 0;
-        cpu->Overflow = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(0);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -188,9 +188,9 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_Should_SetNotZero_SetNotOverflow_SetNotNegative( void ) {
@@ -201,9 +201,9 @@ public:
         mem->LoadFromData(d, sizeof(d));
 
         cpu->A = mask_val;
-        cpu->Zero = 1;
-        cpu->Overflow = 1;
-        cpu->Negative = 1;
+        cpu->SetZero(1);
+        cpu->SetOverflow(1);
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
@@ -212,8 +212,8 @@ public:
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Overflow, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetOverflow(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 };
\ No newline at end of file
@@ -29,13 +29,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 1;
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 1);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size + relative_value);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_WithPositiveValue_WithNegativeSet_WithPageCross( void ) {
@@ -46,13 +46,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 1;
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 2);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size + relative_value);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_WithPositiveValue_WithNegativeNotSet( void ) {
@@ -63,13 +63,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 0;
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_WithNegativeValue_WithNegativeSet( void ) {
@@ -80,13 +80,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 1;
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 1);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size - offset);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_WithNegativeValue_WithNegativeSet_WithPageCross( void ) {
@@ -98,13 +98,13 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 1;
+        cpu->SetNegative(1);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles + 2);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size - offset);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
     }
 
     void test_WithNegativeValue_WithNegativeNotSet( void ) {
@@ -115,12 +115,12 @@ public:
         mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
 
         cpu->PC = pc_start;
-        cpu->Negative = 0;
+        cpu->SetNegative(0);
 
         auto cycles = cpu->RunOneInstruction();
 
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, pc_start + op_size);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 };
\ No newline at end of file
@@ -51,8 +51,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, testing_val);
         TS_ASSERT_EQUALS(cpu->Y, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_WithZeroAndPageCrossed( void ) {
@@ -86,8 +86,8 @@ public:
         TS_ASSERT_EQUALS(cpu->A, testing_val);
         TS_ASSERT_EQUALS(cpu->Y, offset);
 
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_WithZeroAndZeroPageCrossed( void ) {
@@ -130,8 +130,8 @@ public:
         TS_ASSERT_EQUALS(cpu->A, testing_val);
         TS_ASSERT_EQUALS(cpu->Y, offset);
 
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_WithNonZero( void ) {
@@ -164,8 +164,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, testing_val);
         TS_ASSERT_EQUALS(cpu->Y, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
     }
 
     void test_WithNegative( void ) {
@@ -198,8 +198,8 @@ public:
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->A, testing_val);
         TS_ASSERT_EQUALS(cpu->Y, offset);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
         TS_ASSERT_EQUALS(cpu->PC, 2);
     }
     
@@ -38,8 +38,8 @@ public:
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC - pc_start, op_size);
         TS_ASSERT_EQUALS(cpu->A, test_val);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
         TS_ASSERT_EQUALS(cpu->X, offset);
     }
 
@@ -63,8 +63,8 @@ public:
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC - pc_start, op_size);
         TS_ASSERT_EQUALS(cpu->A, test_val);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
         TS_ASSERT_EQUALS(cpu->X+zp_addr, wrapped_addr);
         TS_ASSERT_EQUALS((cpu->X+zp_addr) & 0xFF, 0x05);
     }
@@ -87,8 +87,8 @@ public:
         TS_ASSERT_EQUALS(cpu->A, test_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC - pc_start, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
         TS_ASSERT_EQUALS(cpu->X, offset);
         TS_ASSERT_EQUALS(cpu->X+zp_addr, 0x02);
     }
@@ -111,8 +111,8 @@ public:
         TS_ASSERT_EQUALS(cpu->A, test_val);
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC - pc_start, op_size);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
         TS_ASSERT_EQUALS(cpu->X+zp_addr, 0x05);
     }
     
@@ -26,9 +26,9 @@ public:
         const Byte d[] = {opcode, 0xFF};
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 0;
-        cpu->Zero = 0;
-        cpu->Negative = 0;
+        cpu->SetCarry(0);
+        cpu->SetZero(0);
+        cpu->SetNegative(0);
         cpu->DecimalMode = 0;
         cpu->InterruptDisable = 0;
 
@@ -37,9 +37,9 @@ public:
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->DecimalMode, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 0);
-        TS_ASSERT_EQUALS(cpu->Zero, 0);
-        TS_ASSERT_EQUALS(cpu->Negative, 0);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 0);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 0);
         TS_ASSERT_EQUALS(cpu->InterruptDisable, 0);
     }
 
@@ -47,9 +47,9 @@ public:
         const Byte d[] = {opcode, 0xFF};
         mem->LoadFromData(d, sizeof(d));
 
-        cpu->Carry = 1;
-        cpu->Zero = 1;
-        cpu->Negative = 1;
+        cpu->SetCarry(1);
+        cpu->SetZero(1);
+        cpu->SetNegative(1);
         cpu->DecimalMode = 1;
         cpu->InterruptDisable = 1;
 
@@ -58,9 +58,9 @@ public:
         TS_ASSERT_EQUALS(cycles, op_cycles);
         TS_ASSERT_EQUALS(cpu->PC, op_size);
         TS_ASSERT_EQUALS(cpu->DecimalMode, 1);
-        TS_ASSERT_EQUALS(cpu->Carry, 1);
-        TS_ASSERT_EQUALS(cpu->Zero, 1);
-        TS_ASSERT_EQUALS(cpu->Negative, 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetNegative(), 1);
         TS_ASSERT_EQUALS(cpu->InterruptDisable, 1);
     }
 };
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+#include <jit_cpu.h>
+
+class JitCPU_Tests : public CxxTest::TestSuite 
+{
+public:
+    JitCPU*  cpu;
+    Mem* mem;
+
+    // CLC / LDA #$01 / loop: ADC #$43 / STA $10 / LDX $10 / TXA / ASL A / ROR A /
+    // LSR A / ROL A / AND #$7F / BIT $10 / TAY / TYA / BNE loop / LDY #$05 / (unknown opcode)
+    static constexpr Byte program[] = {
+        0x18, 0xA9, 0x01, 0x69, 0x43, 0x85, 0x10, 0xA6, 0x10, 0x8A, 0x0A, 0x6A,
+        0x4A, 0x2A, 0x29, 0x7F, 0x24, 0x10, 0xA8, 0x98, 0xD0, 0xED, 0xA0, 0x05, 0xFF};
+    static constexpr Word pc_start = 0x8000;
+
+    void setUp() {
+        mem= new Mem();
+        mem->LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        cpu = new JitCPU(mem);
+        cpu->jit_threshold = 1;
+        cpu->PC = pc_start;
+    }
+
+    void tearDown() {
+        delete cpu;
+        delete mem;
+    }
+
+    void CheckRunMatchesCPU(Byte decimal) {
+        Mem other_mem;
+        other_mem.LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        CPU other(&other_mem);
+
+        for (u64 budget = 0; budget < 400; budget += 7) {
+            other.PC = cpu->PC = pc_start;
+            other.A = cpu->A = 0;
+            other.DecimalMode = cpu->DecimalMode = decimal;
+
+            TS_ASSERT_EQUALS(cpu->Run(budget), other.Run(budget));
+            TS_ASSERT_EQUALS(cpu->PC, other.PC);
+            TS_ASSERT_EQUALS(cpu->A, other.A);
+            TS_ASSERT_EQUALS(cpu->X, other.X);
+            TS_ASSERT_EQUALS(cpu->Y, other.Y);
+            TS_ASSERT_EQUALS(cpu->GetZero(), other.GetZero());
+            TS_ASSERT_EQUALS(cpu->GetNegative(), other.GetNegative());
+            TS_ASSERT_EQUALS(cpu->GetCarry(), other.GetCarry());
+            TS_ASSERT_EQUALS(cpu->GetOverflow(), other.GetOverflow());
+            TS_ASSERT_EQUALS(mem->ReadByte(0x10), other_mem.ReadByte(0x10));
+        }
+    }
+
+    void test_Run_should_match_CPU_Run( void ) {
+        CheckRunMatchesCPU(0);
+#if defined(__x86_64__)
+        TS_ASSERT_LESS_THAN(0, cpu->jit_executed);
+#endif
+    }
+
+    void test_Run_should_match_CPU_Run_in_decimal_mode( void ) {
+        CheckRunMatchesCPU(1);
+    }
+
+    void test_Should_compile_after_threshold( void ) {
+        cpu->jit_threshold = 3;
+        cpu->Run(2 + 2);
+        TS_ASSERT_EQUALS(cpu->jit_compiled, 0);
+
+        cpu->Run(1000);
+#if defined(__x86_64__)
+        // [CLC..LDA] is only reached once; the loop body is compiled
+        TS_ASSERT_EQUALS(cpu->jit_compiled, 1);
+#endif
+    }
+
+    void test_Should_recompile_after_code_is_written( void ) {
+        // LDX #$05 / BNE +0
+        const Byte d[] = {0xA2, 0x05, 0xD0, 0x00};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        cpu->PC = pc_start;
+        cpu->Run(2 + 3);
+        auto compiled = cpu->jit_compiled;
+
+        mem->WriteByte(pc_start + 1, 0x09);
+        cpu->PC = pc_start;
+        cpu->Run(2 + 3);
+
+        TS_ASSERT_EQUALS(cpu->X, 0x09);
+#if defined(__x86_64__)
+        TS_ASSERT_EQUALS(cpu->jit_compiled, compiled + 1);
+#endif
+    }
+
+    void test_Should_retry_code_it_rejected_once_written( void ) {
+        // LDA $10,X / BNE +0; LDA $10,X is not translated
+        const Byte d[] = {0xB5, 0x10, 0xD0, 0x00};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        mem->WriteByte(0x10, 0x01);
+        cpu->PC = pc_start;
+        cpu->Run(4 + 3);
+        auto compiled = cpu->jit_compiled;
+
+        // LDA #$10
+        mem->WriteByte(pc_start, 0xA9);
+        cpu->PC = pc_start;
+        cpu->Run(2 + 3);
+
+        TS_ASSERT_EQUALS(cpu->A, 0x10);
+#if defined(__x86_64__)
+        TS_ASSERT_EQUALS(cpu->jit_compiled, compiled + 1);
+        TS_ASSERT_EQUALS(cpu->jit_executed, 1);
+#endif
+    }
+
+    void test_Should_stop_on_code_written_by_the_block( void ) {
+        // STX $8004 / LDA #$00 / BNE +0 ; the store replaces the LDA operand
+        const Byte d[] = {0x8E, 0x04, 0x80, 0xA9, 0x00, 0xD0, 0x00};
+        mem->LoadFromDataAtOffset(d, sizeof(d), pc_start);
+        cpu->X = 0x33;
+        cpu->PC = pc_start;
+
+        TS_ASSERT_EQUALS(cpu->Run(4 + 2 + 3), 4 + 2 + 3);
+
+        TS_ASSERT_EQUALS(cpu->A, 0x33);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(d));
+    }
+};
@@ -0,0 +1,83 @@
+#include <cxxtest/TestSuite.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <machine.h>
+#include <cpu.h>
+#include <mem.h>
+#include "../../bench/bench.h"
+
+class Machine_Tests : public CxxTest::TestSuite
+{
+public:
+
+    void test_Should_run_like_a_cpu_on_mem( void ) {
+        Machine machine;
+        machine.LoadFromData(bench_program, sizeof(bench_program), bench_origin);
+        machine.PC = bench_origin;
+        Mem mem;
+        mem.LoadFromDataAtOffset(bench_program, sizeof(bench_program), bench_origin);
+        CPU cpu(&mem);
+        cpu.PC = bench_origin;
+
+        TS_ASSERT_EQUALS( machine.Run(10000), cpu.Run(10000) );
+        TS_ASSERT_EQUALS( machine.RunOneInstruction(), cpu.RunOneInstruction() );
+        TS_ASSERT_EQUALS( machine.RunUntil(bench_origin), cpu.RunUntil(bench_origin) );
+        TS_ASSERT_EQUALS( machine.PC, cpu.PC );
+        TS_ASSERT_EQUALS( machine.A, cpu.A );
+        TS_ASSERT_EQUALS( machine.X, cpu.X );
+        TS_ASSERT_EQUALS( machine.Y, cpu.Y );
+        TS_ASSERT_EQUALS( machine.SP, cpu.SP );
+        TS_ASSERT_EQUALS( machine.P, cpu.GetStatus() );
+        TS_ASSERT_SAME_DATA( machine.ram, mem.m_data, Mem::max_mem_size );
+    }
+
+    void test_Should_start_in_the_cpu_power_on_state( void ) {
+        Machine machine;
+        CPU cpu(nullptr);
+        TS_ASSERT_EQUALS( machine.PC, cpu.PC );
+        TS_ASSERT_EQUALS( machine.SP, cpu.SP );
+        TS_ASSERT_EQUALS( machine.P, cpu.GetStatus() );
+        TS_ASSERT_EQUALS( machine.ReadWord(0x1234), 0 );
+    }
+
+    void test_Should_copy_as_an_independent_value( void ) {
+        Machine a;
+        a.LoadFromData(bench_program, sizeof(bench_program), bench_origin);
+        a.PC = bench_origin;
+        a.Run(1000);
+
+        Machine b = a;
+        TS_ASSERT_EQUALS( memcmp(&a, &b, sizeof(Machine)), 0 );
+        b.Run(1000);
+        a.Run(1000);
+        TS_ASSERT_EQUALS( memcmp(&a, &b, sizeof(Machine)), 0 );
+
+        b.WriteByte(0x0010, 0x99);
+        b.A = 0x42;
+        TS_ASSERT_DIFFERS( a.ReadByte(0x0010), 0x99 );
+        TS_ASSERT_DIFFERS( a.A, 0x42 );
+
+        std::vector<Machine> machines(3, a);
+        machines.push_back(std::move(b));
+        TS_ASSERT_EQUALS( machines[3].ReadByte(0x0010), 0x99 );
+        for (const Machine& m : machines) {
+            TS_ASSERT_EQUALS( reinterpret_cast<uintptr_t>(&m) % 64, 0u );
+            TS_ASSERT_EQUALS( reinterpret_cast<uintptr_t>(m.ram) % 64, 0u );
+        }
+    }
+
+    void test_Should_load_a_shared_image( void ) {
+        auto image = std::make_shared<const MemImage>(bench_program, sizeof(bench_program), 0xFFF8);
+        std::unique_ptr<Machine> machine(new Machine());
+        machine->WriteByte(0x0000, 0x55);
+        machine->LoadImage(*image);
+        TS_ASSERT_EQUALS( machine->ReadByte(0x0000), 0 );
+        TS_ASSERT_EQUALS( machine->ReadWord(0xFFFF), bench_program[7] );
+        TS_ASSERT_EQUALS( reinterpret_cast<uintptr_t>(machine.get()) % 64, 0u );
+
+        machine->LoadFromData(bench_program, sizeof(bench_program), 0xFFF8);
+        TS_ASSERT_SAME_DATA( machine->ram, image->Page(0), Mem::max_mem_size );
+    }
+};
@@ -0,0 +1,83 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+
+class Run_Tests : public CxxTest::TestSuite 
+{
+public:
+    CPU*  cpu;
+    Mem* mem;
+
+    // LDA #$01 / ASL A / ASL A / BNE -4 / LDX #$05 / (unknown opcode)
+    // A is multiplied by 4 until it shifts out to zero, then falls through to LDX.
+    static constexpr Byte program[] = {0xA9, 0x01, 0x0A, 0x0A, 0xD0, 0xFC, 0xA2, 0x05, 0xFF};
+    static constexpr Word pc_start = 0x8000;
+
+    void setUp() {
+        mem= new Mem();
+        cpu = new CPU(mem);
+        mem->LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        cpu->PC = pc_start;
+    }
+
+    void tearDown() {
+        delete cpu;
+        delete mem;
+    }
+
+    void test_Run_should_match_RunOneInstruction( void ) {
+        Mem other_mem;
+        other_mem.LoadFromDataAtOffset(program, sizeof(program), pc_start);
+        CPU other(&other_mem);
+        other.PC = pc_start;
+
+        u64 expected_cycles = 0;
+        while (expected_cycles < 20) {
+            expected_cycles += other.RunOneInstruction();
+        }
+
+        auto cycles = cpu->Run(20);
+
+        TS_ASSERT_EQUALS(cycles, expected_cycles);
+        TS_ASSERT_EQUALS(cpu->PC, other.PC);
+        TS_ASSERT_EQUALS(cpu->A, other.A);
+        TS_ASSERT_EQUALS(cpu->GetZero(), other.GetZero());
+        TS_ASSERT_EQUALS(cpu->GetNegative(), other.GetNegative());
+        TS_ASSERT_EQUALS(cpu->GetCarry(), other.GetCarry());
+    }
+
+    void test_Run_with_zero_budget_should_do_nothing( void ) {
+        auto cycles = cpu->Run(0);
+
+        TS_ASSERT_EQUALS(cycles, 0);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start);
+    }
+
+    void test_RunUntil_should_stop_at_pc( void ) {
+        // LDA + 3 x (ASL, ASL, BNE taken) + (ASL, ASL, BNE not taken)
+        auto cycles = cpu->RunUntil(Word(pc_start + 6));
+
+        TS_ASSERT_EQUALS(cycles, 2 + 3 * (2 + 2 + 3) + (2 + 2 + 2));
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + 6);
+        TS_ASSERT_EQUALS(cpu->A, 0);
+        TS_ASSERT_EQUALS(cpu->GetZero(), 1);
+        TS_ASSERT_EQUALS(cpu->GetCarry(), 1);
+    }
+
+    void test_RunUntil_should_stop_on_predicate( void ) {
+        auto cycles = cpu->RunUntil([](const CPU& c) { return c.A == 0x10; });
+
+        // stops before the BNE of the second pass
+        TS_ASSERT_EQUALS(cycles, 2 + (2 + 2 + 3) + (2 + 2));
+        TS_ASSERT_EQUALS(cpu->A, 0x10);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + 4);
+    }
+
+    void test_Run_should_stop_on_unknown_opcode( void ) {
+        auto cycles = cpu->Run(1000);
+
+        TS_ASSERT_EQUALS(cycles, 2 + 3 * (2 + 2 + 3) + (2 + 2 + 2) + 2);
+        TS_ASSERT_EQUALS(cpu->X, 0x05);
+        TS_ASSERT_EQUALS(cpu->PC, pc_start + sizeof(program));
+    }
+};
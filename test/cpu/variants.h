@@ -0,0 +1,97 @@
+#include <cxxtest/TestSuite.h>
+#include <cpu.h>
+#include <mem.h>
+
+class Variants_Tests : public CxxTest::TestSuite 
+{
+public:
+    Mem* mem;
+
+    void setUp() {
+        mem= new Mem();
+    }
+
+    void tearDown() {
+        delete mem;
+    }
+
+    template <typename Cpu>
+    u32 RunOne(Cpu& cpu, const Byte* d, size_t size) {
+        mem->LoadFromData(d, size);
+        cpu.PC = 0x0000;
+        return cpu.RunOneInstruction();
+    }
+
+    void test_2A03_should_ignore_decimal_mode( void ) {
+        const Byte d[] = {INS_ADC_IM, 0x01};
+        CPU nmos(mem);
+        CPU2A03 ricoh(mem);
+        nmos.A = ricoh.A = 0x09;
+        nmos.DecimalMode = ricoh.DecimalMode = 1;
+
+        TS_ASSERT_EQUALS(RunOne(nmos, d, sizeof(d)), 2);
+        TS_ASSERT_EQUALS(RunOne(ricoh, d, sizeof(d)), 2);
+
+        TS_ASSERT_EQUALS(nmos.A, 0x10);
+        TS_ASSERT_EQUALS(ricoh.A, 0x0A);
+    }
+
+    void test_65C02_should_take_a_cycle_more_for_decimal_ADC( void ) {
+        const Byte d[] = {INS_ADC_IM, 0x01};
+        CPU65C02 cpu(mem);
+        cpu.A = 0x09;
+
+        TS_ASSERT_EQUALS(RunOne(cpu, d, sizeof(d)), 2);
+        cpu.A = 0x09;
+        cpu.DecimalMode = 1;
+        TS_ASSERT_EQUALS(RunOne(cpu, d, sizeof(d)), 3);
+        TS_ASSERT_EQUALS(cpu.A, 0x10);
+    }
+
+    void test_65C02_should_only_add_a_cycle_to_ASL_ABSX_on_a_page_crossing( void ) {
+        const Byte d[] = {INS_ASL_ABSX, 0x80, 0x01};
+        CPU nmos(mem);
+        CPU65C02 cmos(mem);
+
+        nmos.X = cmos.X = 0x10;
+        TS_ASSERT_EQUALS(RunOne(nmos, d, sizeof(d)), 7);
+        TS_ASSERT_EQUALS(RunOne(cmos, d, sizeof(d)), 6);
+
+        nmos.X = cmos.X = 0x90;
+        TS_ASSERT_EQUALS(RunOne(nmos, d, sizeof(d)), 7);
+        TS_ASSERT_EQUALS(RunOne(cmos, d, sizeof(d)), 7);
+    }
+
+    void test_65C02_should_branch_always( void ) {
+        const Byte d[] = {INS_BRA, 0x10};
+        CPU65C02 cpu(mem);
+
+        TS_ASSERT_EQUALS(RunOne(cpu, d, sizeof(d)), 3);
+        TS_ASSERT_EQUALS(cpu.PC, 0x12);
+    }
+
+    void test_NMOS_should_not_implement_65C02_opcodes( void ) {
+        const Byte d[] = {INS_BRA, 0x10};
+        CPU nmos(mem);
+        CPU2A03 ricoh(mem);
+
+        TS_ASSERT_EQUALS(RunOne(nmos, d, sizeof(d)), 0);
+        TS_ASSERT_EQUALS(RunOne(ricoh, d, sizeof(d)), 0);
+    }
+
+    void test_65C02_should_load_and_store_zero_page_indirect( void ) {
+        // LDA ($10) / ADC #$01 / STA ($12)
+        const Byte d[] = {INS_LDA_ZPI, 0x10, INS_ADC_IM, 0x01, INS_STA_ZPI, 0x12, 0xFF};
+        mem->LoadFromData(d, sizeof(d));
+        mem->WriteWord(0x10, 0x2000);
+        mem->WriteWord(0x12, 0x2001);
+        mem->WriteByte(0x2000, 0x41);
+        CPU65C02 cpu(mem);
+        cpu.PC = 0x0000;
+
+        TS_ASSERT_EQUALS(cpu.Run(5 + 2 + 5), 5 + 2 + 5);
+        TS_ASSERT_EQUALS(cpu.A, 0x42);
+        TS_ASSERT_EQUALS(mem->ReadByte(0x2001), 0x42);
+        TS_ASSERT_EQUALS(cpu.PC, 6);
+    }
+};
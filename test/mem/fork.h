@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../mem.h"
+#include "../../cpu.h"
+
+class MemFork_Tests : public CxxTest::TestSuite
+{
+public:
+
+    Byte data[Mem::max_mem_size];
+    std::shared_ptr<const MemImage> image;
+
+    void setUp() {
+        for (size_t i = 0; i < sizeof(data); ++i) {
+            data[i] = Byte(i * 3);
+        }
+        image = std::make_shared<const MemImage>(data, sizeof(data));
+    }
+
+    void test_Should_share_pages_until_written( void ) {
+        Mem parent;
+        parent.LoadShared(image);
+        parent.WriteByte(0x1234, 0xAA);
+        TS_ASSERT( parent.WritePage(0x12) );
+
+        auto child = parent.Fork();
+        TS_ASSERT_EQUALS( child->PrivatePageCount(), 1u );
+        TS_ASSERT_EQUALS( child->ReadPage(0x12), parent.ReadPage(0x12) );
+        TS_ASSERT_EQUALS( child->ReadByte(0x1234), 0xAA );
+        TS_ASSERT_EQUALS( child->ReadByte(0x4321), data[0x4321] );
+        // neither side may write the shared page in place
+        TS_ASSERT( !parent.WritePage(0x12) );
+        TS_ASSERT( !child->WritePage(0x12) );
+
+        child->WriteByte(0x1235, 0xBB);
+        TS_ASSERT_DIFFERS( child->ReadPage(0x12), parent.ReadPage(0x12) );
+        TS_ASSERT_EQUALS( child->ReadByte(0x1234), 0xAA );
+        TS_ASSERT_EQUALS( child->ReadByte(0x1235), 0xBB );
+        TS_ASSERT_EQUALS( parent.ReadByte(0x1235), data[0x1235] );
+        TS_ASSERT_EQUALS( child->PrivatePageCount(), 1u );
+
+        // the parent holds the old page alone again, so writes it in place
+        const Byte* page = parent.ReadPage(0x12);
+        parent.WriteByte(0x1236, 0xCC);
+        TS_ASSERT_EQUALS( parent.ReadPage(0x12), page );
+        TS_ASSERT_EQUALS( parent.WritePage(0x12), page );
+        TS_ASSERT_EQUALS( child->ReadByte(0x1236), data[0x1236] );
+    }
+
+    void test_Should_keep_the_parent_after_forks_are_dropped( void ) {
+        Mem parent;
+        parent.LoadSparse();
+        parent.WriteByte(0x0010, 0x01);
+        for (int i = 0; i < 10; ++i) {
+            auto child = parent.Fork();
+            child->WriteByte(0x0010, Byte(i));
+            child->WriteByte(0x0300, Byte(i));
+            auto grandchild = child->Fork();
+            TS_ASSERT_EQUALS( grandchild->ReadByte(0x0010), Byte(i) );
+            TS_ASSERT_EQUALS( grandchild->ReadByte(0x0300), Byte(i) );
+        }
+        TS_ASSERT_EQUALS( parent.ReadByte(0x0010), 0x01 );
+        TS_ASSERT_EQUALS( parent.ReadByte(0x0300), 0x00 );
+        TS_ASSERT_EQUALS( parent.PrivatePageCount(), 1u );
+
+        // every fork is gone, so the first write takes the page back
+        parent.WriteByte(0x0011, 0x02);
+        TS_ASSERT( parent.WritePage(0x00) );
+    }
+
+    void test_Should_move_a_flat_mem_onto_an_image( void ) {
+        Mem parent;
+        parent.LoadFromData(data, sizeof(data));
+        parent.WriteByte(0x2000, 0x55);
+        Mem child;
+        child.ForkFrom(parent);
+        TS_ASSERT( !parent.m_data );
+        TS_ASSERT_EQUALS( parent.ReadByte(0x2000), 0x55 );
+        TS_ASSERT_EQUALS( child.ReadByte(0x2000), 0x55 );
+        TS_ASSERT_EQUALS( child.ReadPage(0x20), parent.ReadPage(0x20) );
+
+        child.WriteByte(0x2000, 0x66);
+        TS_ASSERT_EQUALS( parent.ReadByte(0x2000), 0x55 );
+        TS_ASSERT_EQUALS( child.PrivatePageCount(), 1u );
+        TS_ASSERT_EQUALS( parent.PrivatePageCount(), 0u );
+    }
+
+    void test_Should_keep_mappings( void ) {
+        Mem parent;
+        parent.MapROM(0xC0, 0x40);
+        parent.MapMirror(0x08, 1, 0x00);
+        parent.LoadShared(image);
+        auto child = parent.Fork();
+        child->WriteByte(0xC000, 0x11);
+        TS_ASSERT_EQUALS( child->ReadByte(0xC000), data[0xC000] );
+        child->WriteByte(0x0810, 0x22);
+        TS_ASSERT_EQUALS( child->ReadByte(0x0010), 0x22 );
+        TS_ASSERT_EQUALS( parent.ReadByte(0x0010), data[0x0010] );
+        TS_ASSERT( !child->IsPlainRAM() );
+    }
+
+    void test_Should_run_forked_cpus_apart( void ) {
+        // LDA $10 / ADC #$01 / STA $10 / BNE back
+        const Byte program[] = { 0xA5, 0x10, 0x69, 0x01, 0x85, 0x10, 0xD0, 0xF8 };
+        auto rom = std::make_shared<const MemImage>(program, sizeof(program), 0x8000);
+        Mem mem;
+        mem.LoadShared(rom);
+        CPU cpu(&mem);
+        cpu.PC = 0x8000;
+        cpu.Run(100);
+
+        std::vector<std::unique_ptr<Mem>> mems;
+        std::vector<CPU> cpus;
+        for (int i = 0; i < 4; ++i) {
+            mems.push_back(mem.Fork());
+            cpus.push_back(cpu);
+            cpus.back().mem = mems.back().get();
+        }
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&cpus, i] { cpus[i].Run(100 * (i + 1)); });
+        }
+        cpu.Run(1000);
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            Mem expected;
+            expected.LoadShared(rom);
+            CPU reference(&expected);
+            reference.PC = 0x8000;
+            reference.Run(100);
+            reference.Run(100 * (i + 1));
+            TS_ASSERT_EQUALS( cpus[i].PC, reference.PC );
+            TS_ASSERT_EQUALS( cpus[i].A, reference.A );
+            TS_ASSERT_EQUALS( mems[i]->ReadByte(0x0010), expected.ReadByte(0x0010) );
+        }
+    }
+};
@@ -1,4 +1,6 @@
 #include <cxxtest/TestSuite.h>
+#include <cstdio>
+#include <cstring>
 #include "../../mem.h"
 
 class MemLoad_Tests : public CxxTest::TestSuite 
@@ -33,4 +35,86 @@ public:
             TS_ASSERT_EQUALS( mem->m_data[i + offset],  testData[i]);
         }
     }
-};
\ No newline at end of file
+
+    void test_MapFromFile( void ) {
+        const char* path = "mem_load_test.bin";
+        FILE* file = fopen(path, "wb");
+        Byte rom[0x1001] = {};
+        rom[0x0000] = 0x12;
+        rom[0x1000] = 0x34;
+        fwrite(rom, 1, sizeof(rom), file);
+        fclose(file);
+
+        mem->MapFromFile(path);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0000), 0x12 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x1000), 0x34 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x1001), 0x00 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xFFFF), 0x00 );
+
+        // writes stay in memory and never reach the file
+        mem->WriteByte(0x0000, 0x56);
+        mem->WriteByte(0xFFFF, 0x78);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0000), 0x56 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xFFFF), 0x78 );
+        mem->MapFromFile(path);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0000), 0x12 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xFFFF), 0x00 );
+
+        // a copy loaded the old way matches
+        Mem copy;
+        copy.LoadFromFile(path);
+        TS_ASSERT_EQUALS( copy.ReadByte(0x0000), 0x12 );
+        TS_ASSERT_EQUALS( copy.ReadByte(0x1000), 0x34 );
+
+        remove(path);
+    }
+
+    void test_MapFromFile_missing( void ) {
+        mem->MapFromFile("no_such_rom.bin");
+        TS_ASSERT( mem->m_data != nullptr );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8000), 0x00 );
+    }
+
+    void test_Should_reuse_the_buffer_across_loads( void ) {
+        Byte big[0x100];
+        memset(big, 0xAA, sizeof(big));
+        mem->LoadFromData(big, sizeof(big));
+        Byte* buffer = mem->m_data;
+        mem->WriteByte(0x8000, 0x55);
+
+        mem->Unload();
+        TS_ASSERT( mem->m_data == nullptr );
+        mem->LoadFromDataAtOffset(testData, testDataSize, 0x10);
+        TS_ASSERT_EQUALS( mem->m_data, buffer );
+        // everything the new data does not cover is cleared
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0000), 0x00 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0011), 0x12 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x00FF), 0x00 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8000), 0x00 );
+
+        mem->LoadFromData(testData, testDataSize);
+        TS_ASSERT_EQUALS( mem->m_data, buffer );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0011), 0x00 );
+    }
+
+    void test_Should_share_buffers_through_an_arena( void ) {
+        MemArena arena;
+        Byte* first;
+        {
+            Mem a(&arena);
+            a.LoadFromData(testData, testDataSize);
+            first = a.m_data;
+            Mem b(&arena);
+            b.LoadFromData(testData, testDataSize);
+            TS_ASSERT_DIFFERS( b.m_data, first );
+            TS_ASSERT_EQUALS( arena.allocated, 2u );
+        }
+        for (int i = 0; i < 10; ++i) {
+            Mem c(&arena);
+            c.LoadFromDataAtOffset(testData, testDataSize, 0x200);
+            TS_ASSERT_EQUALS( c.ReadByte(0x0001), 0x00 );
+            TS_ASSERT_EQUALS( c.ReadByte(0x0201), 0x12 );
+        }
+        TS_ASSERT_EQUALS( arena.allocated, 2u );
+    }
+};
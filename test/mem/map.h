@@ -0,0 +1,195 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <vector>
+#include "../../mem.h"
+#include "../../cpu.h"
+
+class MemMap_Tests : public CxxTest::TestSuite
+{
+public:
+
+    /*  Records every access and answers reads with the low address byte. */
+    struct Device : MemDevice {
+        std::vector<Word> reads;
+        std::vector<std::pair<Word, Byte>> writes;
+        Byte Read(Word addr) override { reads.push_back(addr); return addr & 0xFF; }
+        void Write(Word addr, Byte data) override { writes.push_back({addr, data}); }
+    };
+
+    struct Watcher : MemWatcher {
+        std::vector<Word> writes;
+        void OnWrite(Word addr) override { writes.push_back(addr); }
+        void OnReload() override {}
+    };
+
+    Mem* mem;
+    Byte zeros[Mem::max_mem_size] = {};
+
+    void setUp() {
+        mem = new Mem();
+        mem->LoadFromData(zeros, sizeof(zeros));
+    }
+
+    void tearDown() {
+        delete mem;
+    }
+
+    void test_Should_be_plain_ram_by_default( void ) {
+        TS_ASSERT( mem->IsPlainRAM() );
+        mem->WriteByte(0x1234, 0x56);
+        TS_ASSERT_EQUALS( mem->m_data[0x1234], 0x56 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x1234), 0x56 );
+        mem->WriteWord(0xFFFF, 0xABCD);
+        TS_ASSERT_EQUALS( mem->ReadByte(0xFFFF), 0xCD );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0000), 0xAB );
+    }
+
+    void test_Should_ignore_writes_to_rom( void ) {
+        mem->m_data[0xC000] = 0x11;
+        mem->MapROM(0xC0, 0x40);
+        TS_ASSERT( !mem->IsPlainRAM() );
+        mem->WriteByte(0xC000, 0x22);
+        mem->WriteWord(0xFFFE, 0x3344);
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC000), 0x11 );
+        TS_ASSERT_EQUALS( mem->ReadWord(0xFFFE), 0x0000 );
+        mem->WriteByte(0xBFFF, 0x33);
+        TS_ASSERT_EQUALS( mem->ReadByte(0xBFFF), 0x33 );
+
+        mem->MapRAM(0xC0, 0x40);
+        TS_ASSERT( mem->IsPlainRAM() );
+        mem->WriteByte(0xC000, 0x22);
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC000), 0x22 );
+    }
+
+    void test_Should_mirror_pages( void ) {
+        // NES style: 2 KB of RAM repeated up to 0x2000
+        for (Byte page = 0x08; page < 0x20; page += 0x08) {
+            mem->MapMirror(page, 0x08, 0x00);
+        }
+        mem->WriteByte(0x0012, 0x34);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0812), 0x34 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x1812), 0x34 );
+        mem->WriteByte(0x1FFF, 0x56);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x07FF), 0x56 );
+        TS_ASSERT_EQUALS( mem->m_data[0x1FFF], 0x00 );
+    }
+
+    void test_Should_send_io_pages_to_the_device( void ) {
+        Device device;
+        mem->MapIO(0x20, 0x01, &device);
+        mem->MapMirror(0x21, 0x01, 0x20);
+
+        TS_ASSERT_EQUALS( mem->ReadByte(0x2007), 0x07 );
+        mem->WriteByte(0x2105, 0x99);
+        TS_ASSERT_EQUALS( mem->ReadWord(0x20FF), 0x00FF );
+        TS_ASSERT_EQUALS( mem->m_data[0x2105], 0x00 );
+
+        TS_ASSERT_EQUALS( device.reads.size(), 3u );
+        TS_ASSERT_EQUALS( device.reads[0], 0x2007 );
+        TS_ASSERT_EQUALS( device.reads[1], 0x20FF );
+        TS_ASSERT_EQUALS( device.reads[2], 0x2100 );
+        TS_ASSERT_EQUALS( device.writes.size(), 1u );
+        TS_ASSERT_EQUALS( device.writes[0].first, 0x2105 );
+        TS_ASSERT_EQUALS( device.writes[0].second, 0x99 );
+    }
+
+    void test_Should_keep_mappings_across_reloads( void ) {
+        Device device;
+        mem->MapIO(0x40, 0x01, &device);
+        mem->Unload();
+        TS_ASSERT_EQUALS( mem->ReadByte(0x4001), 0x01 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0001), 0x00 );
+
+        mem->LoadFromData(zeros, sizeof(zeros));
+        TS_ASSERT_EQUALS( mem->ReadByte(0x4002), 0x02 );
+        mem->WriteByte(0x0001, 0x42);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0001), 0x42 );
+    }
+
+    void test_Should_still_report_watched_writes( void ) {
+        Watcher watcher;
+        mem->SetWatcher(&watcher);
+        mem->Watch(0x0301);
+        mem->WriteByte(0x0300, 0x01);
+        mem->WriteByte(0x0301, 0x02);
+        mem->WriteWord(0x0300, 0x0304);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0301), 0x03 );
+        TS_ASSERT_EQUALS( watcher.writes.size(), 2u );
+
+        mem->SetWatcher(nullptr);
+        mem->WriteByte(0x0301, 0x05);
+        TS_ASSERT_EQUALS( watcher.writes.size(), 2u );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0301), 0x05 );
+    }
+
+    void test_Should_report_writes_through_a_mirror_at_the_watched_address( void ) {
+        Watcher watcher;
+        mem->SetWatcher(&watcher);
+        mem->Watch(0x0301);
+        mem->MapMirror(0x08, 1, 0x03);
+        mem->WriteByte(0x0801, 0x01);
+        mem->WriteByte(0x0800, 0x02);
+        TS_ASSERT_EQUALS( watcher.writes.size(), 1u );
+        TS_ASSERT_EQUALS( watcher.writes[0], 0x0301 );
+
+        // and both addresses when both are watched
+        mem->Watch(0x0801);
+        mem->WriteByte(0x0301, 0x03);
+        TS_ASSERT_EQUALS( watcher.writes.size(), 3u );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0801), 0x03 );
+        mem->SetWatcher(nullptr);
+    }
+
+    void test_Should_let_the_cpu_drive_a_device( void ) {
+        Device device;
+        mem->MapIO(0x40, 0x01, &device);
+        Byte program[] = {
+            0xAD, 0x16, 0x40,   // LDA $4016
+            0x8D, 0x14, 0x40,   // STA $4014
+        };
+        for (size_t i = 0; i < sizeof(program); ++i) {
+            mem->WriteByte(0x8000 + i, program[i]);
+        }
+        CPU cpu(mem);
+        cpu.PC = 0x8000;
+        cpu.RunOneInstruction();
+        cpu.RunOneInstruction();
+        TS_ASSERT_EQUALS( cpu.A, 0x16 );
+        TS_ASSERT_EQUALS( device.writes.size(), 1u );
+        TS_ASSERT_EQUALS( device.writes[0].first, 0x4014 );
+        TS_ASSERT_EQUALS( device.writes[0].second, 0x16 );
+    }
+
+    void test_Should_send_zero_page_accesses_to_a_device_or_watcher( void ) {
+        // LDA $10; STA $20; LDA ($30),Y
+        const Byte program[] = { 0xA5, 0x10, 0x85, 0x20, 0xB1, 0x30 };
+        memcpy(mem->m_data + 0x8000, program, sizeof(program));
+        CPU cpu(mem);
+
+        Watcher watcher;
+        mem->SetWatcher(&watcher);
+        mem->Watch(0x0020);
+        mem->m_data[0x0010] = 0x44;
+        cpu.PC = 0x8000;
+        cpu.RunOneInstruction();
+        cpu.RunOneInstruction();
+        TS_ASSERT_EQUALS( mem->m_data[0x0020], 0x44 );
+        TS_ASSERT_EQUALS( watcher.writes.size(), 1u );
+        TS_ASSERT_EQUALS( watcher.writes[0], 0x0020 );
+        mem->SetWatcher(nullptr);
+
+        Device device;
+        mem->MapIO(0x00, 1, &device);
+        cpu.PC = 0x8000;
+        cpu.RunOneInstruction();
+        TS_ASSERT_EQUALS( cpu.A, 0x10 );
+        cpu.RunOneInstruction();
+        cpu.RunOneInstruction();
+        TS_ASSERT_EQUALS( device.writes.size(), 1u );
+        TS_ASSERT_EQUALS( device.writes[0].first, 0x0020 );
+        TS_ASSERT_EQUALS( device.writes[0].second, 0x10 );
+        // the pointer at $30 reads $3130 from the device
+        TS_ASSERT_EQUALS( device.reads.size(), 3u );
+        TS_ASSERT_EQUALS( cpu.A, mem->m_data[0x3130] );
+    }
+};
@@ -0,0 +1,248 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "../../mem.h"
+#include "../../mapper.h"
+#include "../../cpu.h"
+#include "../../decode_cache.h"
+#include "../../aot_cpu.h"
+#include "../../block_cpu.h"
+
+// bank 0 of BankSwitchingPrg, translated at $8000
+#include "aot_mapper_program.inc"
+
+class Mapper_Tests : public CxxTest::TestSuite
+{
+public:
+
+    Mem* mem;
+    Byte zeros[Mem::max_mem_size] = {};
+
+    void setUp() {
+        mem = new Mem();
+        mem->LoadFromData(zeros, sizeof(zeros));
+    }
+
+    void tearDown() {
+        delete mem;
+    }
+
+    /*  banks 16 KB banks, each starting with LDA #bank and otherwise
+        filled with the bank number.
+    */
+    static std::vector<Byte> Prg(size_t banks) {
+        std::vector<Byte> prg(banks * 0x4000);
+        for (size_t i = 0; i < prg.size(); ++i) {
+            prg[i] = Byte(i / 0x4000);
+        }
+        for (size_t bank = 0; bank < banks; ++bank) {
+            prg[bank * 0x4000] = 0xA9;
+        }
+        return prg;
+    }
+
+    void test_Should_mirror_a_16K_nrom( void ) {
+        std::vector<Byte> prg = Prg(1);
+        prg[0x1234] = 0x77;
+        auto mapper = Mapper::Create(0, prg.data(), prg.size());
+        mapper->Attach(mem);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x9234), 0x77 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xD234), 0x77 );
+        mem->WriteByte(0x9234, 0x00);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x9234), 0x77 );
+        TS_ASSERT( !mem->IsPlainRAM() );
+        mem->WriteByte(0x1234, 0x55);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x1234), 0x55 );
+    }
+
+    void test_Should_switch_uxrom_banks( void ) {
+        std::vector<Byte> prg = Prg(8);
+        auto mapper = Mapper::Create(2, prg.data(), prg.size());
+        mapper->Attach(mem);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 0 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xFFFF), 7 );
+        for (Byte bank = 0; bank < 10; ++bank) {
+            mem->WriteByte(0x8000 + bank, bank);
+            TS_ASSERT_EQUALS( mem->ReadByte(0xBFFF), bank & 7 );
+            TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 7 );
+        }
+    }
+
+    void test_Should_switch_32K_axrom_and_gxrom_banks( void ) {
+        std::vector<Byte> prg = Prg(8);
+        auto axrom = Mapper::Create(7, prg.data(), prg.size());
+        axrom->Attach(mem);
+        mem->WriteByte(0x8000, 0x12);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 4 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 5 );
+
+        auto gxrom = Mapper::Create(66, prg.data(), prg.size());
+        gxrom->Attach(mem);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 0 );
+        mem->WriteByte(0x8000, 0x30);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 6 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 7 );
+    }
+
+    void WriteMmc1(Word addr, Byte value) {
+        for (int bit = 0; bit < 5; ++bit) {
+            mem->WriteByte(addr, (value >> bit) & 1);
+        }
+    }
+
+    void test_Should_load_mmc1_registers_serially( void ) {
+        std::vector<Byte> prg = Prg(16);
+        auto mapper = Mapper::Create(1, prg.data(), prg.size());
+        mapper->Attach(mem);
+        // powers on with the last bank fixed at $C000
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 0 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 15 );
+
+        WriteMmc1(0xE000, 5);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 5 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 15 );
+
+        // a write with bit 7 set restarts the sequence
+        mem->WriteByte(0xE000, 1);
+        mem->WriteByte(0xE000, 0x80);
+        WriteMmc1(0xE000, 6);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 6 );
+
+        // first bank fixed at $8000
+        WriteMmc1(0x8000, 0x08);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 0 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 6 );
+
+        // 32 KB banks
+        WriteMmc1(0x8000, 0x00);
+        WriteMmc1(0xE000, 9);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 8 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC001), 9 );
+
+        // CHR registers leave PRG alone
+        WriteMmc1(0xA000, 3);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 8 );
+    }
+
+    void test_Should_read_ines_images( void ) {
+        std::vector<Byte> prg = Prg(4);
+        std::vector<Byte> file = { 'N', 'E', 'S', 0x1A, 4, 1, 0x24, 0x00, 0, 0, 0, 0, 0, 0, 0, 0 };
+        file.resize(16 + 512);
+        file.insert(file.end(), prg.begin(), prg.end());
+        file.resize(file.size() + 0x2000);
+
+        auto mapper = Mapper::FromINes(file.data(), file.size());
+        TS_ASSERT( mapper );
+        TS_ASSERT_EQUALS( mapper->Prg().size(), prg.size() );
+        mapper->Attach(mem);
+        mem->WriteByte(0x8000, 2);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 2 );
+
+        file[6] = 0x54;     // mapper 5 is not supported
+        TS_ASSERT( !Mapper::FromINes(file.data(), file.size()) );
+        file[0] = 'X';
+        TS_ASSERT( !Mapper::FromINes(file.data(), file.size()) );
+        TS_ASSERT( !Mapper::FromINes(file.data(), 8) );
+    }
+
+    void test_Should_switch_banks_in_a_fork_alone( void ) {
+        std::vector<Byte> prg = Prg(16);
+        auto mapper = Mapper::Create(1, prg.data(), prg.size());
+        mapper->Attach(mem);
+        WriteMmc1(0xE000, 5);
+        // halfway through loading a register
+        mem->WriteByte(0xE000, 1);
+        mem->WriteByte(0xE000, 1);
+
+        auto child = mem->Fork();
+        TS_ASSERT_EQUALS( child->ReadByte(0x8001), 5 );
+        // the fork goes on from the mapper's state
+        for (int i = 0; i < 3; ++i) {
+            child->WriteByte(0xE000, 0);
+        }
+        TS_ASSERT_EQUALS( child->ReadByte(0x8001), 3 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 5 );
+
+        mem->WriteByte(0xE000, 0x80);
+        WriteMmc1(0xE000, 9);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x8001), 9 );
+        TS_ASSERT_EQUALS( child->ReadByte(0x8001), 3 );
+
+        // and keeps the ROM once the parent's mapper is gone
+        mem->MapRAM(0x80, 0x80);
+        mapper.reset();
+        for (int i = 0; i < 5; ++i) {
+            child->WriteByte(0xE000, (7 >> i) & 1);
+        }
+        TS_ASSERT_EQUALS( child->ReadByte(0x8001), 7 );
+        TS_ASSERT_EQUALS( child->ReadByte(0xC001), 15 );
+    }
+
+    void test_Should_keep_a_decode_cache_in_step_with_bank_switches( void ) {
+        std::vector<Byte> prg = Prg(4);
+        auto mapper = Mapper::Create(2, prg.data(), prg.size());
+        mapper->Attach(mem);
+        CPU cpu(mem);
+        DecodeCache cache(mem);
+        cpu.decode_cache = &cache;
+
+        for (Byte bank = 0; bank < 3; ++bank) {
+            mem->WriteByte(0x8000, bank);
+            cpu.PC = 0x8000;
+            cpu.RunOneInstruction();
+            TS_ASSERT_EQUALS( cpu.A, bank );
+        }
+        TS_ASSERT_EQUALS( cache.misses, 3u );
+    }
+
+    /*  Two 16 KB banks for UxROM. Bank 0 switches to bank 1 from $8000:
+
+        $8000: LDA #$01
+               STA $8000
+               LDX #$05
+               .byte $FF
+
+        and bank 1 has LDX #$77 / .byte $FF where LDX #$05 was.
+    */
+    static std::vector<Byte> BankSwitchingPrg() {
+        std::vector<Byte> prg(0x8000);
+        const Byte bank0[] = { 0xA9, 0x01, 0x8D, 0x00, 0x80, 0xA2, 0x05, 0xFF };
+        const Byte bank1[] = { 0xA2, 0x77, 0xFF };
+        memcpy(prg.data(), bank0, sizeof(bank0));
+        memcpy(prg.data() + 0x4005, bank1, sizeof(bank1));
+        return prg;
+    }
+
+    void test_Should_keep_translated_code_in_step_with_bank_switches( void ) {
+        std::vector<Byte> prg = BankSwitchingPrg();
+        auto mapper = Mapper::Create(2, prg.data(), prg.size());
+        mapper->Attach(mem);
+        AotCPU cpu(mem, aot_mapper_program);
+
+        for (int run = 1; run <= 3; ++run) {
+            mem->WriteByte(0x8000, 0);
+            cpu.PC = 0x8000;
+            cpu.Run(1000);
+            TS_ASSERT_EQUALS( cpu.X, 0x77 );
+            TS_ASSERT_EQUALS( cpu.PC, 0x8008 );
+            // the block ran up to the switch every time
+            TS_ASSERT_EQUALS( cpu.aot_blocks_run, u64(run) );
+        }
+    }
+
+    void test_Should_keep_blocks_in_step_with_bank_switches( void ) {
+        std::vector<Byte> prg = BankSwitchingPrg();
+        auto mapper = Mapper::Create(2, prg.data(), prg.size());
+        mapper->Attach(mem);
+        BlockCPU cpu(mem);
+
+        for (int run = 0; run < 3; ++run) {
+            mem->WriteByte(0x8000, 0);
+            cpu.PC = 0x8000;
+            cpu.Run(1000);
+            TS_ASSERT_EQUALS( cpu.X, 0x77 );
+            TS_ASSERT_EQUALS( cpu.PC, 0x8008 );
+        }
+    }
+};
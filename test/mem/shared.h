@@ -0,0 +1,135 @@
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include "../../mem.h"
+#include "../../cpu.h"
+
+class MemShared_Tests : public CxxTest::TestSuite
+{
+public:
+
+    Byte data[Mem::max_mem_size];
+    std::shared_ptr<const MemImage> image;
+
+    void setUp() {
+        for (size_t i = 0; i < sizeof(data); ++i) {
+            data[i] = Byte(i * 3);
+        }
+        image = std::make_shared<const MemImage>(data, sizeof(data));
+    }
+
+    void test_Should_read_the_shared_image( void ) {
+        Mem mem;
+        mem.LoadShared(image);
+        TS_ASSERT( !mem.m_data );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x1234), data[0x1234] );
+        TS_ASSERT_EQUALS( mem.ReadWord(0xFFFE), data[0xFFFE] | data[0xFFFF] << 8 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 0u );
+    }
+
+    void test_Should_copy_pages_on_first_write( void ) {
+        Mem a, b;
+        a.LoadShared(image);
+        b.LoadShared(image);
+        a.WriteByte(0x1234, 0xAA);
+        a.WriteByte(0x1235, 0xBB);
+        TS_ASSERT_EQUALS( a.PrivatePageCount(), 1u );
+        TS_ASSERT_EQUALS( a.ReadByte(0x1234), 0xAA );
+        TS_ASSERT_EQUALS( a.ReadByte(0x1235), 0xBB );
+        TS_ASSERT_EQUALS( a.ReadByte(0x1236), data[0x1236] );
+        TS_ASSERT_EQUALS( b.ReadByte(0x1234), data[0x1234] );
+        TS_ASSERT_EQUALS( b.PrivatePageCount(), 0u );
+        TS_ASSERT_EQUALS( image->Page(0x12)[0x34], data[0x1234] );
+
+        a.WriteWord(0x20FF, 0x1122);
+        TS_ASSERT_EQUALS( a.PrivatePageCount(), 3u );
+        TS_ASSERT_EQUALS( a.ReadWord(0x20FF), 0x1122 );
+    }
+
+    void test_Should_keep_rom_and_mirrors( void ) {
+        Mem mem;
+        mem.MapROM(0xC0, 0x40);
+        mem.MapMirror(0x08, 1, 0x00);
+        mem.LoadShared(image);
+        mem.WriteByte(0xC000, 0x11);
+        TS_ASSERT_EQUALS( mem.ReadByte(0xC000), data[0xC000] );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 0u );
+
+        mem.WriteByte(0x0810, 0x22);
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0010), 0x22 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0810), 0x22 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 1u );
+    }
+
+    void test_Should_release_the_image_on_load( void ) {
+        Mem mem;
+        mem.LoadShared(image);
+        mem.WriteByte(0x0010, 0x22);
+        TS_ASSERT_EQUALS( image.use_count(), 2 );
+        mem.LoadFromData(data, sizeof(data));
+        TS_ASSERT_EQUALS( image.use_count(), 1 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 0u );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0010), data[0x10] );
+    }
+
+    void test_Should_run_the_cpu_on_a_shared_image( void ) {
+        // LDA #$42; STA $10; STA $0300
+        const Byte program[] = { 0xA9, 0x42, 0x85, 0x10, 0x8D, 0x00, 0x03 };
+        auto rom = std::make_shared<const MemImage>(program, sizeof(program), 0x8000);
+        Mem mem;
+        mem.LoadShared(rom);
+        CPU cpu(&mem);
+        cpu.PC = 0x8000;
+        TS_ASSERT_EQUALS( cpu.Run(9), 9u );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0010), 0x42 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0300), 0x42 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0301), 0x00 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 2u );
+    }
+
+    void test_Should_read_zero_from_untouched_sparse_memory( void ) {
+        Mem mem;
+        mem.LoadSparse();
+        TS_ASSERT( !mem.m_data );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x1234), 0x00 );
+        TS_ASSERT_EQUALS( mem.ReadWord(0xFFFE), 0x0000 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 0u );
+
+        mem.WriteByte(0x1234, 0xAA);
+        TS_ASSERT_EQUALS( mem.ReadByte(0x1234), 0xAA );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x1235), 0x00 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x2234), 0x00 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 1u );
+
+        Mem other;
+        other.LoadSparse();
+        TS_ASSERT_EQUALS( other.ReadByte(0x1234), 0x00 );
+    }
+
+    void test_Should_load_data_into_sparse_pages( void ) {
+        Mem mem;
+        mem.LoadSparse(data + 0x80F0, 0x20, 0x80F0);
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 2u );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x80EF), 0x00 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x80F0), data[0x80F0] );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x810F), data[0x810F] );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x8110), 0x00 );
+
+        mem.LoadSparse(data, 0x10, 0xFFF8);
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 1u );
+        TS_ASSERT_EQUALS( mem.ReadByte(0xFFFF), data[7] );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0000), 0x00 );
+    }
+
+    void test_Should_run_the_cpu_on_sparse_memory( void ) {
+        // LDA #$42; STA $10; STA $0300
+        const Byte program[] = { 0xA9, 0x42, 0x85, 0x10, 0x8D, 0x00, 0x03 };
+        Mem mem;
+        mem.LoadSparse(program, sizeof(program), 0x8000);
+        CPU cpu(&mem);
+        cpu.PC = 0x8000;
+        TS_ASSERT_EQUALS( cpu.Run(9), 9u );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0010), 0x42 );
+        TS_ASSERT_EQUALS( mem.ReadByte(0x0300), 0x42 );
+        TS_ASSERT_EQUALS( mem.PrivatePageCount(), 3u );
+    }
+};
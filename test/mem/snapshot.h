@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <vector>
+#include "../../mem.h"
+#include "../../cpu.h"
+
+class MemSnapshot_Tests : public CxxTest::TestSuite
+{
+public:
+
+    struct Watcher : MemWatcher {
+        std::vector<Word> writes;
+        void OnWrite(Word addr) override { writes.push_back(addr); }
+        void OnReload() override {}
+    };
+
+    Mem* mem;
+    Byte image[Mem::max_mem_size];
+
+    void setUp() {
+        for (size_t i = 0; i < sizeof(image); ++i) {
+            image[i] = Byte(i * 3);
+        }
+        mem = new Mem();
+        mem->LoadFromData(image, sizeof(image));
+    }
+
+    void tearDown() {
+        delete mem;
+    }
+
+    void test_Should_restore_only_dirty_pages( void ) {
+        mem->Snapshot();
+        TS_ASSERT( mem->HasSnapshot() );
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 0u );
+
+        mem->WriteByte(0x0010, 0xAA);
+        mem->WriteByte(0x0011, 0xBB);
+        mem->WriteWord(0x01FF, 0x1234);
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0010), 0xAA );
+        TS_ASSERT_EQUALS( mem->ReadWord(0x01FF), 0x1234 );
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 3u );
+        TS_ASSERT( mem->IsDirty(0x00) );
+        TS_ASSERT( mem->IsDirty(0x01) );
+        TS_ASSERT( mem->IsDirty(0x02) );
+        TS_ASSERT( !mem->IsDirty(0x03) );
+
+        mem->Restore();
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 0u );
+        TS_ASSERT_SAME_DATA( mem->m_data, image, sizeof(image) );
+
+        // tracking carries on after a restore
+        mem->WriteByte(0x0010, 0xCC);
+        TS_ASSERT( mem->IsDirty(0x00) );
+        mem->Restore();
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0010), image[0x10] );
+    }
+
+    void test_Should_restore_what_the_cpu_wrote( void ) {
+        // LDA #$42; STA $10; STA $0300
+        const Byte program[] = { 0xA9, 0x42, 0x85, 0x10, 0x8D, 0x00, 0x03 };
+        memcpy(mem->m_data + 0x8000, program, sizeof(program));
+        memcpy(image + 0x8000, program, sizeof(program));
+        mem->Snapshot();
+
+        CPU cpu(mem);
+        cpu.PC = 0x8000;
+        cpu.RunOneInstruction();
+        cpu.RunOneInstruction();
+        cpu.RunOneInstruction();
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0010), 0x42 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0300), 0x42 );
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 2u );
+
+        mem->Restore();
+        TS_ASSERT_SAME_DATA( mem->m_data, image, sizeof(image) );
+    }
+
+    void test_Should_track_writes_through_mirrors( void ) {
+        mem->MapMirror(0x08, 1, 0x00);
+        mem->Snapshot();
+        mem->WriteByte(0x0810, 0xAA);
+        TS_ASSERT( mem->IsDirty(0x00) );
+        TS_ASSERT( !mem->IsDirty(0x08) );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0010), 0xAA );
+        mem->Restore();
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0010), image[0x10] );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0810), image[0x10] );
+
+        mem->WriteByte(0x0011, 0xBB);
+        mem->WriteByte(0x0812, 0xCC);
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 1u );
+        mem->Restore();
+        TS_ASSERT_SAME_DATA( mem->m_data, image, sizeof(image) );
+    }
+
+    void test_Should_tell_the_watcher_about_restored_bytes( void ) {
+        Watcher watcher;
+        mem->SetWatcher(&watcher);
+        mem->Watch(0x0400);
+        mem->Watch(0x0401);
+        mem->Snapshot();
+        mem->WriteByte(0x0400, 0x99);
+        mem->WriteByte(0x0402, 0x99);
+        TS_ASSERT_EQUALS( watcher.writes.size(), 1u );
+        mem->Restore();
+        TS_ASSERT_EQUALS( watcher.writes.size(), 2u );
+        TS_ASSERT_EQUALS( watcher.writes.back(), 0x0400 );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0400), image[0x400] );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x0402), image[0x402] );
+        mem->SetWatcher(nullptr);
+    }
+
+    void test_Should_drop_the_snapshot_on_load( void ) {
+        mem->Snapshot();
+        mem->WriteByte(0x2000, 0x55);
+        mem->LoadFromData(image, sizeof(image));
+        TS_ASSERT( !mem->HasSnapshot() );
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 0u );
+        mem->WriteByte(0x2000, 0x66);
+        mem->Restore();
+        TS_ASSERT_EQUALS( mem->ReadByte(0x2000), 0x66 );
+
+        mem->Snapshot();
+        mem->DropSnapshot();
+        TS_ASSERT( !mem->HasSnapshot() );
+        mem->WriteByte(0x2000, 0x77);
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 0u );
+        TS_ASSERT_EQUALS( mem->ReadByte(0x2000), 0x77 );
+    }
+
+    void test_Should_not_write_to_rom_under_a_snapshot( void ) {
+        mem->MapROM(0xC0, 0x40);
+        mem->Snapshot();
+        mem->WriteByte(0xC000, 0x11);
+        TS_ASSERT_EQUALS( mem->ReadByte(0xC000), image[0xC000] );
+        TS_ASSERT_EQUALS( mem->DirtyPageCount(), 0u );
+    }
+};
@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+#include <vector>
+#include "../../mem.h"
+#include "../../mem_trace.h"
+
+class MemTrace_Tests : public CxxTest::TestSuite
+{
+public:
+
+    std::vector<MemAccess> drained;
+    size_t batches;
+
+    void setUp() {
+        drained.clear();
+        batches = 0;
+    }
+
+    MemTrace::Sink Collect() {
+        return [this](const MemAccess* accesses, size_t count) {
+            drained.insert(drained.end(), accesses, accesses + count);
+            ++batches;
+        };
+    }
+
+    void test_Should_drain_accesses_in_order( void ) {
+        {
+            MemTrace trace(Collect(), 16);
+            for (u32 i = 0; i < 1000; ++i) {
+                trace.Record(Word(i), Word(i * 3), MEM_WRITE_BYTE);
+                if (i % 8 == 7) {
+                    trace.Flush();
+                }
+            }
+            TS_ASSERT_EQUALS( trace.dropped, 0u );
+        }
+        TS_ASSERT_EQUALS( drained.size(), 1000u );
+        for (u32 i = 0; i < drained.size(); ++i) {
+            TS_ASSERT_EQUALS( drained[i].addr, Word(i) );
+            TS_ASSERT_EQUALS( drained[i].value, Word(i * 3) );
+            TS_ASSERT_EQUALS( drained[i].kind, MEM_WRITE_BYTE );
+        }
+    }
+
+    void test_Should_drop_accesses_when_full( void ) {
+        u64 dropped;
+        {
+            // The sink blocks until released, so the ring cannot drain.
+            std::atomic<bool> release(false);
+            MemTrace trace([&](const MemAccess* accesses, size_t count) {
+                while (!release) {
+                    std::this_thread::yield();
+                }
+                drained.insert(drained.end(), accesses, accesses + count);
+            }, 4);
+            for (u32 i = 0; i < 100; ++i) {
+                trace.Record(Word(i), 0, MEM_READ_BYTE);
+            }
+            dropped = trace.dropped;
+            release = true;
+        }
+        TS_ASSERT_EQUALS( drained.size() + dropped, 100u );
+        TS_ASSERT( drained.size() >= 4u );
+        TS_ASSERT( drained.size() <= 8u );
+    }
+
+    void test_Should_record_mem_accesses_when_built_with_tracing( void ) {
+        Mem mem;
+        Byte data[] = {0x11, 0x22, 0x33};
+        mem.LoadFromData(data, sizeof(data));
+        {
+            MemTrace trace(Collect());
+            mem.trace = &trace;
+            mem.ReadByte(0x0001);
+            mem.WriteByte(0x0002, 0x44);
+            mem.ReadWord(0x0000);
+            mem.WriteWord(0x0010, 0xBEEF);
+            mem.trace = nullptr;
+            mem.ReadByte(0x0000);
+        }
+        if (!Mem::trace_enabled) {
+            TS_ASSERT( drained.empty() );
+            return;
+        }
+        TS_ASSERT_EQUALS( drained.size(), 4u );
+        TS_ASSERT_EQUALS( drained[0].kind, MEM_READ_BYTE );
+        TS_ASSERT_EQUALS( drained[0].value, 0x22 );
+        TS_ASSERT_EQUALS( drained[1].kind, MEM_WRITE_BYTE );
+        TS_ASSERT_EQUALS( drained[1].addr, 0x0002 );
+        TS_ASSERT_EQUALS( drained[2].kind, MEM_READ_WORD );
+        TS_ASSERT_EQUALS( drained[2].value, 0x2211 );
+        TS_ASSERT_EQUALS( drained[3].kind, MEM_WRITE_WORD );
+        TS_ASSERT_EQUALS( drained[3].value, 0xBEEF );
+    }
+};
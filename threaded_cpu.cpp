@@ -0,0 +1,79 @@
+#include "threaded_cpu.h"
+#include "mem.h"
+#include "opcodes.h"
+
+ThreadedCPU::ThreadedCPU(Mem *m) : CPU(m) {
+
+}
+
+u32 ThreadedCPU::RunOneInstruction() {
+    return (u32)Run(1);
+}
+
+#if defined(__GNUC__)
+
+/*  Position of each opcode's label in the label table built inside Run.
+    Slot 0 is the unknown opcode handler.
+*/
+static constexpr std::array<Byte, 0x100> BuildSlotTable() {
+    std::array<Byte, 0x100> slots{};
+    Byte next = 1;
+#define THREADED_SLOT(name, ...) slots[INS_##name] = next++;
+    CPU_OPCODES(THREADED_SLOT)
+#undef THREADED_SLOT
+    return slots;
+}
+
+static constexpr std::array<Byte, 0x100> s_slots = BuildSlotTable();
+
+u64 ThreadedCPU::Run(u64 cycle_budget) {
+#define THREADED_LABEL(name, ...) &&op_##name,
+    static void* const labels[] = { &&op_unknown, CPU_OPCODES(THREADED_LABEL) };
+#undef THREADED_LABEL
+
+    u64 cycles = 0;
+    Byte opcode;
+    Word operand = 0;
+
+    // Only the opcode is read before the jump; each handler then fetches
+    // its operand, whose size is known at compile time.
+#define DISPATCH() do {                                     \
+        if (cycles >= cycle_budget) {                       \
+            return cycles;                                  \
+        }                                                   \
+        opcode = mem->ReadByte(PC++);                       \
+        goto *labels[s_slots[opcode]];                      \
+    } while(false)
+
+    DISPATCH();
+
+#define THREADED_HANDLER(name, mode, base_cycles)           \
+    op_##name:                                              \
+        operand = FetchOperand(OperandSize(AM_##mode));     \
+        cycles += base_cycles + Op_##name(operand);         \
+        DISPATCH();
+    CPU_OPCODES(THREADED_HANDLER)
+#undef THREADED_HANDLER
+
+op_unknown:
+    Op_Unknown(operand);
+    return cycles;
+
+#undef DISPATCH
+}
+
+#else
+
+u64 ThreadedCPU::Run(u64 cycle_budget) {
+    u64 cycles = 0;
+    while (cycles < cycle_budget) {
+        u32 c = CPU::RunOneInstruction();
+        if (c == 0) {
+            break;
+        }
+        cycles += c;
+    }
+    return cycles;
+}
+
+#endif
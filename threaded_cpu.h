@@ -0,0 +1,34 @@
+#pragma once
+#include "cpu.h"
+
+/*  CPU execution engine that uses threaded code instead of a central
+    dispatch. Every handler ends with its own indirect jump straight to the
+    handler of the next opcode (GCC/Clang labels-as-values), so the branch
+    predictor sees one jump site per opcode instead of a single shared one.
+
+    Registers and flags are the ones inherited from CPU, so a ThreadedCPU
+    can be used anywhere a CPU is set up and inspected. It ignores
+    decode_cache: fetching the operand in the handler, at a size known at
+    compile time, is cheaper than a cache lookup before the jump (see
+    bench/decode_cache.cpp).
+*/
+class ThreadedCPU : public CPU {
+public:
+
+    ThreadedCPU(Mem* );
+
+    u32 RunOneInstruction();
+
+    /*  Runs instructions until at least cycle_budget cycles have been used
+        or an unknown opcode is hit. Returns the cycles actually used.
+    */
+    u64 Run(u64 cycle_budget);
+};
+
+/*  The instruction suites under test/ construct a CPU directly. Building
+    them with -include threaded_cpu.h -DTEST_THREADED_CPU (see
+    'make test-threaded') runs the same suites against ThreadedCPU.
+*/
+#ifdef TEST_THREADED_CPU
+#define CPU ThreadedCPU
+#endif
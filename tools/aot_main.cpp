@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../aot_cpu.h"
+#include "../mem.h"
+
+extern const AotProgram aot_program;
+
+/*  Runs a ROM with its ahead-of-time translation linked in, and the same
+    ROM with CPU::Run for comparison.
+
+    usage: 6502-aot rom [entry] [cycles]
+*/
+template<typename Engine>
+static void Time(const char* name, Engine& engine, Word entry, u64 cycles) {
+    engine.PC = entry;
+    auto start = std::chrono::steady_clock::now();
+    u64 ran = engine.Run(cycles);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-12s %llu cycles in %.3fs, %.2f emulated MHz, PC=$%04X\n",
+        name, (unsigned long long)ran, seconds, ran / seconds / 1e6, engine.PC);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s rom [entry] [cycles]\n", argv[0]);
+        return 1;
+    }
+
+    Mem mem;
+    mem.LoadFromFile(argv[1]);
+    Word entry = argc > 2
+        ? Word(strtoul(argv[2], nullptr, 16))
+        : Word(mem.ReadByte(0xFFFC) | (mem.ReadByte(0xFFFD) << 8));
+    u64 cycles = argc > 3 ? strtoull(argv[3], nullptr, 10) : 100000000;
+
+    AotCPU aot(&mem, aot_program);
+    Time("AotCPU::Run", aot, entry, cycles);
+    printf("blocks run: %llu interpreted: %llu rejected: %llu\n",
+        (unsigned long long)aot.aot_blocks_run, (unsigned long long)aot.aot_interpreted,
+        (unsigned long long)aot.aot_rejected);
+
+    Mem cpu_mem;
+    cpu_mem.LoadFromFile(argv[1]);
+    CPU cpu(&cpu_mem);
+    Time("CPU::Run", cpu, entry, cycles);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+#include "../fuzz.h"
+
+/*  A fuzz target for afl-fuzz, built with `make fuzz`.
+
+    usage: 6502-fuzz rom stop_pc [entry [input_addr [max_cycles]]]
+
+    Addresses are hex, and entry defaults to the reset vector. Each input
+    is read from stdin. Under afl-fuzz, e.g.
+
+        afl-fuzz -i seeds -o findings -- bin/6502-fuzz rom.bin 8015
+
+    the ROM is loaded once, a fork server hands out children, and each
+    child runs up to 1000 inputs in persistent mode, restoring only the
+    memory the last one dirtied. An unknown opcode aborts so afl-fuzz
+    records a crash. Run by hand, it runs stdin once and prints the result.
+*/
+
+// afl-fuzz looks for this in the binary to turn on persistent mode
+static volatile const char afl_persistent[] = "##SIG_AFL_PERSISTENT##";
+
+static constexpr u64 inputs_per_child = 1000;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s rom stop_pc [entry [input_addr [max_cycles]]]\n", argv[0]);
+        return 1;
+    }
+    (void)afl_persistent;
+
+    FuzzConfig config;
+    config.stop_pc = Word(strtoul(argv[2], nullptr, 16));
+    if (argc > 3) {
+        config.entry = Word(strtoul(argv[3], nullptr, 16));
+    }
+    if (argc > 4) {
+        config.input_addr = Word(strtoul(argv[4], nullptr, 16));
+    }
+    if (argc > 5) {
+        config.max_cycles = strtoull(argv[5], nullptr, 10);
+    }
+    Fuzzer fuzzer(config);
+    fuzzer.LoadFromFile(argv[1]);
+
+    bool afl = fuzzer.AttachAflMap();
+    bool served = afl && fuzzer.ServeForks(true);
+
+    std::vector<Byte> input(config.max_input);
+    while (fuzzer.Loop(served ? inputs_per_child : 1)) {
+        // afl-fuzz rewrites the same file for every input
+        lseek(0, 0, SEEK_SET);
+        ssize_t size = read(0, input.data(), input.size());
+        fuzzer.Run(input.data(), size > 0 ? size_t(size) : 0);
+        if (!afl) {
+            static const char* names[] = { "stopped", "timed out", "crashed" };
+            printf("%s at $%04X after %llu cycles\n",
+                names[fuzzer.status], fuzzer.PC, (unsigned long long)fuzzer.cycles);
+            fflush(stdout);
+        }
+        if (fuzzer.status == FUZZ_CRASH) {
+            abort();
+        }
+    }
+    return 0;
+}
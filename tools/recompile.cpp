@@ -0,0 +1,40 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../aot_cpu.h"
+#include "../mem.h"
+
+/*  Translates a ROM image to C++ ahead of time, see AotCPU.
+
+    usage: recompile rom output.cpp [entry ...]
+
+    Entry points are hex addresses; without any, the reset vector at $FFFC
+    is used. The output defines `const AotProgram aot_program`.
+*/
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s rom output.cpp [entry ...]\n", argv[0]);
+        return 1;
+    }
+
+    Mem mem;
+    mem.LoadFromFile(argv[1]);
+
+    std::vector<Word> entry_points;
+    for (int i = 3; i < argc; ++i) {
+        entry_points.push_back(Word(strtoul(argv[i], nullptr, 16)));
+    }
+    if (entry_points.empty()) {
+        entry_points.push_back(mem.ReadByte(0xFFFC) | (mem.ReadByte(0xFFFD) << 8));
+    }
+
+    std::ofstream out(argv[2]);
+    out << AotCompile(mem, entry_points, "aot_program");
+    if (!out) {
+        fprintf(stderr, "could not write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}
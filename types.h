@@ -4,4 +4,5 @@
 
 typedef uint8_t  Byte;
 typedef uint16_t Word;
-typedef u_int32_t u32;
+typedef uint32_t u32;
+typedef uint64_t u64;